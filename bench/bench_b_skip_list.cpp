@@ -0,0 +1,86 @@
+/**
+ * @file bench_b_skip_list.cpp
+ * @brief Вставка, поиск и обход: b_skip_list, skip_list и std::set
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/b_skip_list.hpp"
+#include "../include/skip_list.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename F>
+double seconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename Set>
+void measure(const std::string& name, const std::vector<uint64_t>& keys,
+             const std::vector<uint64_t>& probes) {
+    Set set;
+    double insert = seconds([&] {
+        for (uint64_t key : keys) {
+            set.insert(key);
+        }
+    });
+
+    size_t found = 0;
+    double lookup = seconds([&] {
+        for (uint64_t key : probes) {
+            found += set.count(key);
+        }
+    });
+
+    uint64_t sum = 0;
+    double scan = seconds([&] {
+        for (uint64_t key : set) {
+            sum += key;
+        }
+    });
+    if (found == 0 || sum == 0) {
+        std::cerr << "unexpected empty result" << std::endl;
+    }
+
+    auto mops = [](size_t n, double s) { return static_cast<double>(n) / s / 1e6; };
+    std::cout << name << "," << keys.size() << "," << mops(keys.size(), insert) << ","
+              << mops(probes.size(), lookup) << "," << mops(set.size(), scan) << std::endl;
+}
+
+} // namespace
+
+/**
+ * Аргумент: число элементов (по умолчанию 10^7)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> dist(0, 4 * n);
+    std::vector<uint64_t> keys(n);
+    for (auto& key : keys) {
+        key = dist(gen);
+    }
+    std::vector<uint64_t> probes(1000000);
+    for (size_t i = 0; i < probes.size(); ++i) {
+        probes[i] = i % 2 == 0 ? keys[gen() % n] : dist(gen);
+    }
+
+    std::cout << "structure,elements,minserts_per_second,mlookups_per_second,mscan_per_second"
+              << std::endl;
+    measure<stl::b_skip_list<uint64_t>>("b_skip_list", keys, probes);
+    measure<stl::skip_list<uint64_t>>("skip_list", keys, probes);
+    measure<std::set<uint64_t>>("std::set", keys, probes);
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file bench_external_sort.cpp
+ * @brief Внешняя сортировка случайных ключей: длина серий и время
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/external_sort.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+/**
+ * Аргументы: число элементов (по умолчанию 1 << 22), элементов в памяти
+ * (по умолчанию 1 << 16), каталог серий (по умолчанию временный каталог)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 22);
+    size_t memory = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : (1u << 16);
+    std::filesystem::path dir = argc > 3 ? std::filesystem::path(argv[3])
+                                         : std::filesystem::temp_directory_path() /
+                                               "bench_external_sort";
+
+    std::mt19937_64 gen(1);
+    stl::external_sorter<uint64_t> sorter(stl::external_sort_options{dir.string(), memory, 64});
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < n; ++i) {
+        sorter.push(gen());
+    }
+    uint64_t previous = 0;
+    uint64_t count = 0;
+    bool sorted = true;
+    sorter.finish([&](uint64_t value) {
+        sorted = sorted && value >= previous;
+        previous = value;
+        ++count;
+    });
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    std::filesystem::remove_all(dir);
+
+    if (!sorted || count != n) {
+        std::cerr << "output is not sorted" << std::endl;
+        return 1;
+    }
+
+    std::cout << "elements,memory,runs,run_length_over_memory,merge_passes,melements_per_second"
+              << std::endl;
+    std::cout << n << "," << memory << "," << sorter.initial_runs() << ","
+              << static_cast<double>(n) / sorter.initial_runs() / memory << ","
+              << sorter.merge_passes() << "," << n / elapsed.count() / 1e6 << std::endl;
+    return 0;
+}
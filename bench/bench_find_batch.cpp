@@ -0,0 +1,60 @@
+/**
+ * @file bench_find_batch.cpp
+ * @brief Поиск целых ключей в skip_list по одному и пакетами find_batch
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/skip_list.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * Аргумент: число элементов (по умолчанию 1 << 20)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> dist(0, 2 * n);
+
+    stl::skip_list<uint64_t> list;
+    while (list.size() < n) {
+        list.insert(dist(gen));
+    }
+    const auto& view = list;
+
+    std::vector<uint64_t> probes(1000000);
+    for (auto& key : probes) {
+        key = dist(gen);
+    }
+
+    size_t single_hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t key : probes) {
+        single_hits += view.find(key) != view.end();
+    }
+    auto single = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    size_t batch_hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& it : view.find_batch(probes)) {
+        batch_hits += it != view.end();
+    }
+    auto batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    if (single_hits != batch_hits) {
+        std::cerr << "hit counts differ" << std::endl;
+        return 1;
+    }
+
+    std::cout << "mode,elements,mlookups_per_second" << std::endl;
+    std::cout << "find," << n << "," << probes.size() / single.count() / 1e6 << std::endl;
+    std::cout << "find_batch," << n << "," << probes.size() / batch.count() / 1e6 << std::endl;
+    return 0;
+}
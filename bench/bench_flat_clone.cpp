@@ -0,0 +1,58 @@
+/**
+ * @file bench_flat_clone.cpp
+ * @brief Копирование skip_list поэлементно против memcpy кучи flat_skip_list
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/flat_skip_list.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+/**
+ * Аргументы: число элементов (по умолчанию 1 << 18), число копий
+ * (по умолчанию 20)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 18);
+    int clones = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> dist(0, 4 * n);
+    stl::skip_list<uint64_t> list;
+    stl::flat_skip_list<uint64_t> flat;
+    while (list.size() < n) {
+        uint64_t key = dist(gen);
+        list.insert(key);
+        flat.insert(key);
+    }
+
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < clones; ++i) {
+        stl::skip_list<uint64_t> copy(list);
+        checksum += copy.size();
+    }
+    auto node_copy = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < clones; ++i) {
+        stl::flat_skip_list<uint64_t> copy(flat);
+        checksum -= copy.size();
+    }
+    auto flat_copy = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    if (checksum != 0) {
+        std::cerr << "sizes differ" << std::endl;
+        return 1;
+    }
+
+    std::cout << "mode,elements,clones_per_second" << std::endl;
+    std::cout << "skip_list_copy," << n << "," << clones / node_copy.count() << std::endl;
+    std::cout << "flat_skip_list_copy," << n << "," << clones / flat_copy.count() << std::endl;
+    return 0;
+}
@@ -0,0 +1,280 @@
+/**
+ * @file bench_harness.hpp
+ * @brief Общий каркас многопоточных бенчмарков списков с пропусками
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#include "../include/skip_list.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace bench {
+
+/**
+ * @brief Базовая линия: skip_list под одним мьютексом
+ */
+template<typename T = int>
+struct locked_skip_list {
+    using value_type = T;
+
+    stl::skip_list<T> list;
+    std::mutex mutex;
+
+    bool insert(const T& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.insert(key).second;
+    }
+
+    size_t erase(const T& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.erase(key);
+    }
+
+    bool contains(const T& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.count(key) != 0;
+    }
+};
+
+/**
+ * @brief Сериализует писателей структуры с одним писателем
+ *
+ * Читатели обращаются к списку напрямую, писатели - под мьютексом.
+ */
+template<typename List>
+struct single_writer {
+    using value_type = typename List::value_type;
+
+    List list;
+    std::mutex writer_mutex;
+
+    template<typename K>
+    bool insert(const K& key) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        return list.insert(key).second;
+    }
+
+    template<typename K>
+    size_t erase(const K& key) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        return list.erase(key);
+    }
+
+    template<typename K>
+    bool contains(const K& key) {
+        return list.contains(key);
+    }
+};
+
+/**
+ * @brief Распределение Ципфа на [0, n) по схеме YCSB
+ *
+ * theta <= 0 дает равномерное распределение; чем ближе theta к 1, тем
+ * сильнее перекос. Горячие ключи - наименьшие, поэтому перекос создает
+ * горячий диапазон, а не разбросанные горячие точки. Схема YCSB
+ * рассчитана на 0 < theta < 1: при theta >= 1 ее аппроксимация хвоста
+ * перестает быть распределением на [0, n).
+ *
+ * @throws std::out_of_range при theta >= 1
+ */
+class zipf_distribution {
+public:
+    zipf_distribution(uint64_t n, double theta) : n_(n), theta_(theta) {
+        if (!(theta_ < 1.0)) {
+            // alpha = 1 / (1 - theta) не определено или отрицательно
+            throw std::out_of_range("Zipf theta must be below 1");
+        }
+        if (theta_ <= 0.0) {
+            return;
+        }
+        double zeta2 = zeta(2, theta_);
+        zetan_ = zeta(n_, theta_);
+        alpha_ = 1.0 / (1.0 - theta_);
+        eta_ = (1.0 - std::pow(2.0 / static_cast<double>(n_), 1.0 - theta_)) /
+               (1.0 - zeta2 / zetan_);
+        half_pow_theta_ = 1.0 + std::pow(0.5, theta_);
+    }
+
+    template<typename Generator>
+    uint64_t operator()(Generator& gen) const {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        double u = uniform(gen);
+        if (theta_ <= 0.0) {
+            return std::min(static_cast<uint64_t>(u * static_cast<double>(n_)), n_ - 1);
+        }
+
+        double uz = u * zetan_;
+        if (uz < 1.0) {
+            return 0;
+        }
+        if (uz < half_pow_theta_) {
+            return 1;
+        }
+        auto key = static_cast<uint64_t>(static_cast<double>(n_) *
+                                         std::pow(eta_ * u - eta_ + 1.0, alpha_));
+        return std::min(key, n_ - 1);
+    }
+
+private:
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0.0;
+        for (uint64_t i = 1; i <= n; ++i) {
+            sum += 1.0 / std::pow(static_cast<double>(i), theta);
+        }
+        return sum;
+    }
+
+    uint64_t n_;
+    double theta_;
+    double zetan_ = 0.0;
+    double alpha_ = 0.0;
+    double eta_ = 0.0;
+    double half_pow_theta_ = 0.0;
+};
+
+/// Закрепляет текущий поток за ядром core (по модулю числа ядер)
+inline void pin_to_core(unsigned core) {
+#ifdef __linux__
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % cores, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+/// Потоков прогона сверх рабочих: главный (заполняет список) и фоновый
+/// поток структуры, например обслуживание nohotspot_skip_list
+constexpr unsigned HARNESS_THREADS = 2;
+
+/// Наибольшее число рабочих потоков, вместе с HARNESS_THREADS - 256
+constexpr unsigned MAX_WORKERS = 256 - HARNESS_THREADS;
+
+/**
+ * @brief Параметры одной точки кривой масштабируемости
+ */
+struct workload {
+    unsigned threads = 1;
+    int read_percent = 90;       ///< остальное поровну делят вставки и удаления
+    double zipf_theta = 0.0;
+    uint64_t key_range = 1 << 16;
+    uint64_t ops_per_thread = 100000;
+    unsigned repeats = 3;
+};
+
+struct result {
+    double median_mops = 0.0;
+    double min_mops = 0.0;
+    double max_mops = 0.0;
+};
+
+/**
+ * @brief Один прогон: потоки закреплены за ядрами и стартуют одновременно
+ * @return Пропускная способность в миллионах операций в секунду
+ */
+template<typename List>
+double run_once(List& list, const workload& w, const zipf_distribution& keys) {
+    using key_type = typename List::value_type;
+    for (uint64_t key = 0; key < w.key_range; key += 2) {
+        list.insert(static_cast<key_type>(key));
+    }
+
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < w.threads; ++t) {
+        workers.emplace_back([&, t] {
+            pin_to_core(t);
+            std::mt19937_64 gen(t + 1);
+            std::uniform_int_distribution<int> op_dist(0, 99);
+
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            for (uint64_t i = 0; i < w.ops_per_thread; ++i) {
+                auto key = static_cast<key_type>(keys(gen));
+                int op = op_dist(gen);
+                if (op < w.read_percent) {
+                    list.contains(key);
+                } else if ((op - w.read_percent) % 2 == 0) {
+                    list.insert(key);
+                } else {
+                    list.erase(key);
+                }
+            }
+        });
+    }
+
+    while (ready.load() != w.threads) {
+        std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    return static_cast<double>(w.threads) * static_cast<double>(w.ops_per_thread) /
+           elapsed.count() / 1e6;
+}
+
+/**
+ * @brief Повторяет прогон на свежем экземпляре List и возвращает медиану
+ * @throws std::out_of_range если число потоков вне [1, MAX_WORKERS]
+ */
+template<typename List>
+result run(const workload& w) {
+    if (w.threads == 0 || w.threads > MAX_WORKERS) {
+        throw std::out_of_range("Benchmark thread count must be in [1, " +
+                                std::to_string(MAX_WORKERS) + "]");
+    }
+    zipf_distribution keys(w.key_range, w.zipf_theta);
+    std::vector<double> samples;
+    for (unsigned i = 0; i < std::max(1u, w.repeats); ++i) {
+        List list;
+        samples.push_back(run_once(list, w, keys));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples.front(), samples.back()};
+}
+
+inline void write_csv_header(std::ostream& out) {
+    out << "structure,threads,read_percent,zipf_theta,median_mops,min_mops,max_mops\n";
+}
+
+inline void write_csv_row(std::ostream& out, const std::string& structure,
+                          const workload& w, const result& r) {
+    out << structure << ',' << w.threads << ',' << w.read_percent << ','
+        << w.zipf_theta << ',' << r.median_mops << ',' << r.min_mops << ','
+        << r.max_mops << std::endl;
+}
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_HPP
@@ -0,0 +1,61 @@
+/**
+ * @file bench_index_cache.cpp
+ * @brief Поиск в skip_list без кэша верхних уровней и с кэшем разной глубины
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/skip_list.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+double lookups_per_second(const stl::skip_list<uint64_t>& list,
+                          const std::vector<uint64_t>& probes) {
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t key : probes) {
+        found += list.count(key);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    if (found == 0) {
+        std::cerr << "no hits" << std::endl;
+    }
+    return static_cast<double>(probes.size()) / elapsed.count() / 1e6;
+}
+
+} // namespace
+
+/**
+ * Аргумент: число элементов (по умолчанию 1 << 20)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> dist(0, 2 * n);
+
+    stl::skip_list<uint64_t> list;
+    while (list.size() < n) {
+        list.insert(dist(gen));
+    }
+
+    std::vector<uint64_t> probes(1000000);
+    for (auto& key : probes) {
+        key = dist(gen);
+    }
+
+    std::cout << "index_level,cached_nodes,elements,mlookups_per_second" << std::endl;
+    for (size_t level : {0, 4, 3, 2}) {
+        list.set_index_cache(level);
+        std::cout << level << "," << list.index_cache_size() << "," << n << ","
+                  << lookups_per_second(list, probes) << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+/**
+ * @file bench_nohotspot.cpp
+ * @brief Масштабируемость nohotspot_skip_list от 1 до 64 потоков
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "bench_harness.hpp"
+#include "../include/nohotspot_skip_list.hpp"
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * Смешанная нагрузка: 80% поиск, 10% вставка, 10% удаление,
+ * равномерные ключи. Аргумент: число операций на поток.
+ */
+int main(int argc, char** argv) {
+    bench::workload w;
+    w.read_percent = 80;
+    w.ops_per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    w.repeats = 1;
+
+    std::cout << "threads,nohotspot_mops,locked_skip_list_mops" << std::endl;
+    for (unsigned threads = 1; threads <= 64; threads *= 2) {
+        w.threads = threads;
+        double nohotspot = bench::run<stl::nohotspot_skip_list<int>>(w).median_mops;
+        double locked = bench::run<bench::locked_skip_list<int>>(w).median_mops;
+        std::cout << threads << "," << nohotspot << "," << locked << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_persistent_open.cpp
+ * @brief Запуск с готовым списком: открытие persistent_skip_list против
+ *        перестроения skip_list из отсортированного файла
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/persistent_skip_list.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Аргументы: число элементов (по умолчанию 1 << 20), каталог файлов
+ * (по умолчанию временный каталог)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+    std::filesystem::path dir = argc > 2 ? argv[2] : std::filesystem::temp_directory_path();
+    std::string heap_path = (dir / "bench_persistent_open.heap").string();
+    std::string dump_path = (dir / "bench_persistent_open.dump").string();
+    std::filesystem::remove(heap_path);
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> dist(0, 4 * n);
+    std::vector<uint64_t> keys;
+    {
+        stl::persistent_skip_list<uint64_t> heap(heap_path);
+        while (heap.size() < n) {
+            heap.insert(dist(gen));
+        }
+        keys.assign(heap.begin(), heap.end());
+    }
+    {
+        std::ofstream out(dump_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(keys.data()),
+                  static_cast<std::streamsize>(keys.size() * sizeof(uint64_t)));
+    }
+
+    std::vector<uint64_t> probes(100000);
+    for (auto& key : probes) {
+        key = dist(gen);
+    }
+
+    // Время до ответа на первые запросы
+    auto start = std::chrono::steady_clock::now();
+    size_t rebuilt_hits = 0;
+    {
+        std::ifstream in(dump_path, std::ios::binary);
+        std::vector<uint64_t> loaded(n);
+        in.read(reinterpret_cast<char*>(loaded.data()),
+                static_cast<std::streamsize>(n * sizeof(uint64_t)));
+        stl::skip_list<uint64_t> list;
+        for (uint64_t key : loaded) {
+            list.insert(key);
+        }
+        for (uint64_t key : probes) {
+            rebuilt_hits += list.count(key);
+        }
+    }
+    auto rebuild = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    size_t mapped_hits = 0;
+    {
+        stl::persistent_skip_list<uint64_t> heap(heap_path);
+        for (uint64_t key : probes) {
+            mapped_hits += heap.count(key);
+        }
+    }
+    auto mapped = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    std::filesystem::remove(heap_path);
+    std::filesystem::remove(dump_path);
+    if (rebuilt_hits != mapped_hits) {
+        std::cerr << "hit counts differ" << std::endl;
+        return 1;
+    }
+
+    std::cout << "mode,elements,startup_seconds" << std::endl;
+    std::cout << "rebuild," << n << "," << rebuild.count() << std::endl;
+    std::cout << "persistent_open," << n << "," << mapped.count() << std::endl;
+    return 0;
+}
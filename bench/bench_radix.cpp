@@ -0,0 +1,66 @@
+/**
+ * @file bench_radix.cpp
+ * @brief Поиск в radix_skip_list и skip_list на плотном пространстве идентификаторов
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../include/radix_skip_list.hpp"
+#include "../include/skip_list.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+template<typename List>
+double lookups_per_second(const List& list, const std::vector<uint64_t>& probes) {
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t key : probes) {
+        found += list.count(key);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    if (found == 0) {
+        std::cerr << "no hits" << std::endl;
+    }
+    return static_cast<double>(probes.size()) / elapsed.count() / 1e6;
+}
+
+} // namespace
+
+/**
+ * Аргумент: число элементов (по умолчанию 1 << 20)
+ */
+int main(int argc, char** argv) {
+    uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1u << 20);
+    unsigned key_bits = 1;
+    while ((uint64_t{1} << key_bits) < 2 * n) {
+        ++key_bits;
+    }
+
+    std::mt19937_64 gen(1);
+    std::uniform_int_distribution<uint64_t> dist(0, (uint64_t{1} << key_bits) - 1);
+
+    stl::skip_list<uint64_t> plain;
+    stl::radix_skip_list<uint64_t> radix(key_bits > 4 ? key_bits - 4 : 0, key_bits, 1);
+    while (plain.size() < n) {
+        uint64_t key = dist(gen);
+        plain.insert(key);
+        radix.insert(key);
+    }
+
+    std::vector<uint64_t> probes(1000000);
+    for (auto& key : probes) {
+        key = dist(gen);
+    }
+
+    std::cout << "structure,elements,mlookups_per_second" << std::endl;
+    std::cout << "skip_list," << n << "," << lookups_per_second(plain, probes) << std::endl;
+    std::cout << "radix_skip_list," << n << "," << lookups_per_second(radix, probes) << std::endl;
+    return 0;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file bench_scalability.cpp
+ * @brief Кривые масштабируемости конкурентных списков с пропусками
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "bench_harness.hpp"
+#include "../include/left_right_skip_list.hpp"
+#include "../include/nohotspot_skip_list.hpp"
+#include "../include/swmr_skip_list.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+template<typename List>
+void sweep(const std::string& name, bench::workload w, unsigned max_threads) {
+    for (int read_percent : {50, 90, 99, 100}) {
+        for (double theta : {0.0, 0.8, 0.99}) {
+            for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+                w.threads = threads;
+                w.read_percent = read_percent;
+                w.zipf_theta = theta;
+                bench::write_csv_row(std::cout, name, w, bench::run<List>(w));
+            }
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * Аргументы: [операций на поток] [максимум потоков] [повторов]
+ */
+int main(int argc, char** argv) {
+    bench::workload w;
+    w.ops_per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000;
+    unsigned max_threads = std::min(2 * std::max(1u, std::thread::hardware_concurrency()),
+                                    bench::MAX_WORKERS);
+    if (argc > 2) {
+        char* end = nullptr;
+        unsigned long requested = std::strtoul(argv[2], &end, 10);
+        if (*end != '\0' || requested == 0 || requested > bench::MAX_WORKERS) {
+            std::cerr << "max threads must be in [1, " << bench::MAX_WORKERS << "], got '"
+                      << argv[2] << "'" << std::endl;
+            return 1;
+        }
+        max_threads = static_cast<unsigned>(requested);
+    }
+    w.repeats = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 3;
+
+    bench::write_csv_header(std::cout);
+    sweep<bench::locked_skip_list<int>>("locked_skip_list", w, max_threads);
+    sweep<bench::single_writer<stl::swmr_skip_list<int>>>("swmr_skip_list", w, max_threads);
+    sweep<stl::left_right_skip_list<int>>("left_right_skip_list", w, max_threads);
+    sweep<stl::nohotspot_skip_list<int>>("nohotspot_skip_list", w, max_threads);
+    return 0;
+}
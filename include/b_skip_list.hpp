@@ -0,0 +1,369 @@
+/**
+ * @file b_skip_list.hpp
+ * @brief B-список с пропусками: узлы-массивы ключей на каждом уровне
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef B_SKIP_LIST_HPP
+#define B_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+/**
+ * @brief Упорядоченное множество в виде B-списка с пропусками
+ *
+ * Каждый уровень - список узлов, хранящих отсортированные массивы ключей.
+ * Вместо башни узла на следующий уровень продвигается сам ключ: с
+ * вероятностью 1/FANOUT он попадает уровнем выше, и на всех уровнях ниже
+ * своей вершины начинает новый узел. Ключ уровня i > 0 ссылается вниз на
+ * узел уровня i - 1, который он начинает, поэтому узлы содержат в среднем
+ * FANOUT ключей, а поиск читает подряд лежащие массивы, как в B-дереве.
+ *
+ * Вставка делит узлы только по продвигаемому ключу, удаление сливает
+ * узел, который ключ начинал, с предыдущим - без перебалансировки.
+ *
+ * @tparam NodeBytes Целевой размер массива ключей узла в байтах
+ */
+template<typename T, typename Compare = std::less<T>, size_t NodeBytes = 256>
+class b_skip_list {
+    struct node {
+        std::vector<T> keys;
+        std::vector<node*> down;   ///< пусто на уровне 0
+        node* next = nullptr;
+        node* lead = nullptr;      ///< у голов уровней выше 0 - голова уровня ниже
+    };
+
+public:
+    using value_type = T;
+    using key_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_compare = Compare;
+
+    /// Среднее число ключей в узле
+    static constexpr size_type FANOUT = std::max<size_type>(4, NodeBytes / sizeof(T));
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const_iterator(const node* n, size_t pos) : node_(n), pos_(pos) {
+            while (node_ && pos_ >= node_->keys.size()) {
+                node_ = node_->next;
+                pos_ = 0;
+            }
+        }
+
+        reference operator*() const {
+            if (!node_) {
+                throw std::runtime_error("Dereferencing null iterator");
+            }
+            return node_->keys[pos_];
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (node_ && ++pos_ == node_->keys.size()) {
+                node_ = node_->next;
+                pos_ = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return node_ == other.node_ && pos_ == other.pos_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const node* node_ = nullptr;
+        size_t pos_ = 0;
+    };
+
+    using iterator = const_iterator;
+
+private:
+    std::vector<node*> heads_;   ///< heads_[i] - голова уровня i
+    size_type size_ = 0;
+    value_compare comp_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+
+public:
+    explicit b_skip_list(const Compare& comp = Compare())
+        : comp_(comp), gen_(std::random_device{}()), dist_(0.0, 1.0) {
+        heads_.push_back(new node);
+    }
+
+    b_skip_list(std::initializer_list<T> init, const Compare& comp = Compare())
+        : b_skip_list(comp) {
+        for (const auto& value : init) {
+            insert(value);
+        }
+    }
+
+    b_skip_list(const b_skip_list&) = delete;
+    b_skip_list& operator=(const b_skip_list&) = delete;
+
+    ~b_skip_list() {
+        release_nodes();
+    }
+
+    // Итераторы
+    const_iterator begin() const noexcept {
+        return const_iterator(heads_.front(), 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    /// Число уровней, включая уровень 0
+    size_type levels() const noexcept {
+        return heads_.size();
+    }
+
+    // Модификаторы
+    std::pair<iterator, bool> insert(const value_type& value) {
+        const_iterator found = lower_bound(value);
+        if (found != end() && !comp_(value, *found)) {
+            return {found, false};
+        }
+
+        size_type height = random_height();
+        while (heads_.size() <= height) {
+            auto* head = new node;
+            head->lead = heads_.back();
+            heads_.push_back(head);
+        }
+
+        // Ключ вставляется в узел на уровне height и начинает новые узлы
+        // ниже; above - запись уровнем выше, чья ссылка вниз еще не задана
+        node* current = heads_.back();
+        node* above = nullptr;
+        size_type above_pos = 0;
+        iterator result;
+        for (size_type level = heads_.size(); level-- > 0;) {
+            current = advance(current, value);
+            size_type pos = position(current, value);
+            node* below = level == 0 ? nullptr : child(current, pos);
+
+            if (level == height) {
+                current->keys.insert(current->keys.begin() + pos, value);
+                if (level > 0) {
+                    current->down.insert(current->down.begin() + pos, nullptr);
+                }
+                above = current;
+                above_pos = pos;
+            } else if (level < height) {
+                node* fresh = split(current, pos, value, level);
+                above->down[above_pos] = fresh;
+                above = fresh;
+                above_pos = 0;
+                current = fresh;
+                pos = 0;
+            }
+            if (level == 0) {
+                result = iterator(current, pos);
+            }
+            current = below;
+        }
+
+        ++size_;
+        return {result, true};
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    size_type erase(const value_type& key) {
+        if (!contains(key)) {
+            return 0;
+        }
+
+        node* current = heads_.back();
+        for (size_type level = heads_.size(); level-- > 0;) {
+            current = advance(current, key);
+            size_type pos = position(current, key);
+            node* below = level == 0 ? nullptr : child(current, pos);
+
+            if (pos < current->keys.size() && !comp_(key, current->keys[pos])) {
+                // Вершина ключа: он лежит внутри узла
+                current->keys.erase(current->keys.begin() + pos);
+                if (level > 0) {
+                    current->down.erase(current->down.begin() + pos);
+                }
+            } else if (current->next && !comp_(key, current->next->keys.front())) {
+                // Ниже вершины ключ начинает узел - сливаем его с предыдущим
+                merge_next(current);
+            }
+            current = below;
+        }
+
+        while (heads_.size() > 1 && heads_.back()->keys.empty() && !heads_.back()->next) {
+            delete heads_.back();
+            heads_.pop_back();
+        }
+        --size_;
+        return 1;
+    }
+
+    void clear() noexcept {
+        release_nodes();
+        heads_.clear();
+        heads_.push_back(new node);
+        size_ = 0;
+    }
+
+    // Поиск
+    const_iterator find(const value_type& key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool contains(const value_type& key) const {
+        return find(key) != end();
+    }
+
+    size_type count(const value_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    const_iterator lower_bound(const value_type& key) const {
+        const node* current = heads_.back();
+        for (size_type level = heads_.size() - 1; level > 0; --level) {
+            current = advance(current, key);
+            current = child(current, position(current, key));
+        }
+        current = advance(current, key);
+        return const_iterator(current, position(current, key));
+    }
+
+    const_iterator upper_bound(const value_type& key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && !comp_(key, *it) ? std::next(it) : it;
+    }
+
+    // Наблюдатели
+    value_compare value_comp() const {
+        return comp_;
+    }
+
+private:
+    size_type random_height() {
+        size_type height = 0;
+        while (dist_(gen_) * FANOUT < 1.0 && height < MAX_LEVEL - 1) {
+            ++height;
+        }
+        return height;
+    }
+
+    // Последний узел уровня, начинающийся с ключа меньше key
+    template<typename Node>
+    Node* advance(Node* n, const value_type& key) const {
+        while (n->next && comp_(n->next->keys.front(), key)) {
+            n = n->next;
+        }
+        return n;
+    }
+
+    // Позиция первого ключа узла, не меньшего key
+    size_type position(const node* n, const value_type& key) const {
+        return static_cast<size_type>(
+            std::lower_bound(n->keys.begin(), n->keys.end(), key, comp_) - n->keys.begin());
+    }
+
+    // Узел уровнем ниже, содержащий ключи перед позицией pos; pos = 0
+    // возможна только в голове уровня
+    static node* child(const node* n, size_type pos) noexcept {
+        return pos == 0 ? n->lead : n->down[pos - 1];
+    }
+
+    // Отделяет ключи начиная с pos в новый узел, который начинает value
+    node* split(node* n, size_type pos, const value_type& value, size_type level) {
+        auto* fresh = new node;
+        fresh->keys.reserve(std::max(FANOUT, n->keys.size() - pos + 1));
+        fresh->keys.push_back(value);
+        fresh->keys.insert(fresh->keys.end(), std::make_move_iterator(n->keys.begin() + pos),
+                           std::make_move_iterator(n->keys.end()));
+        n->keys.erase(n->keys.begin() + pos, n->keys.end());
+        if (level > 0) {
+            fresh->down.push_back(nullptr);
+            fresh->down.insert(fresh->down.end(), n->down.begin() + pos, n->down.end());
+            n->down.erase(n->down.begin() + pos, n->down.end());
+        }
+        fresh->next = n->next;
+        n->next = fresh;
+        return fresh;
+    }
+
+    // Переносит в n ключи следующего узла, кроме первого, и удаляет его
+    static void merge_next(node* n) {
+        node* doomed = n->next;
+        n->keys.insert(n->keys.end(), std::make_move_iterator(doomed->keys.begin() + 1),
+                       std::make_move_iterator(doomed->keys.end()));
+        if (!doomed->down.empty()) {
+            n->down.insert(n->down.end(), doomed->down.begin() + 1, doomed->down.end());
+        }
+        n->next = doomed->next;
+        delete doomed;
+    }
+
+    void release_nodes() noexcept {
+        for (node* head : heads_) {
+            node* current = head;
+            while (current) {
+                node* next = current->next;
+                delete current;
+                current = next;
+            }
+        }
+    }
+};
+
+} // namespace stl
+
+#endif // B_SKIP_LIST_HPP
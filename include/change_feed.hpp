@@ -0,0 +1,230 @@
+/**
+ * @file change_feed.hpp
+ * @brief Кольцевой журнал изменений контейнера для инкрементальных потребителей
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef CHANGE_FEED_HPP
+#define CHANGE_FEED_HPP
+
+#include "skip_list.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace stl {
+
+enum class change_op : uint8_t {
+    insert,
+    erase,
+    clear                              ///< value не задано
+};
+
+template<typename T>
+struct change_event {
+    uint64_t sequence = 0;
+    change_op op = change_op::insert;
+    T value{};
+};
+
+/**
+ * @brief Последние capacity изменений с последовательными номерами
+ *
+ * Владелец контейнера публикует события (см. change_publisher),
+ * потребители читают их со своей позиции - номера следующего
+ * непрочитанного события - из любых потоков. Новое событие вытесняет
+ * самое старое; потребитель, чья позиция вытеснена, получает отказ
+ * (переполнение) и должен пересинхронизироваться: взять позицию
+ * next_sequence() и, в потоке владельца, перечитать нужный диапазон
+ * контейнера. События до этой позиции уже отражены в контейнере.
+ */
+template<typename T>
+class change_feed {
+public:
+    explicit change_feed(size_t capacity) : ring_(capacity) {
+        if (capacity == 0) {
+            throw std::out_of_range("Change feed capacity must be positive");
+        }
+    }
+
+    change_feed(const change_feed&) = delete;
+    change_feed& operator=(const change_feed&) = delete;
+
+    size_t capacity() const noexcept {
+        return ring_.size();
+    }
+
+    void publish(change_op op, const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        change_event<T>& slot = ring_[next_ % ring_.size()];
+        slot.sequence = next_;
+        slot.op = op;
+        slot.value = value;
+        ++next_;
+    }
+
+    /// Событие clear не копирует значение и не бросает исключений
+    void publish_clear() noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        change_event<T>& slot = ring_[next_ % ring_.size()];
+        slot.sequence = next_;
+        slot.op = change_op::clear;
+        ++next_;
+    }
+
+    /// Номер следующего публикуемого события
+    uint64_t next_sequence() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return next_;
+    }
+
+    /// Номер самого старого события в журнале
+    uint64_t oldest_sequence() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return oldest();
+    }
+
+    /**
+     * @brief Добавляет в out до max событий, начиная с position
+     *
+     * position сдвигается за прочитанные события.
+     *
+     * @return false, если событие position уже вытеснено; out и position
+     *         тогда не меняются
+     */
+    bool read(uint64_t& position, std::vector<change_event<T>>& out, size_t max) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (position < oldest()) {
+            return false;
+        }
+        if (position > next_) {
+            throw std::out_of_range("Change feed position is ahead of the feed");
+        }
+        for (; position < next_ && max > 0; ++position, --max) {
+            out.push_back(ring_[position % ring_.size()]);
+        }
+        return true;
+    }
+
+private:
+    uint64_t oldest() const noexcept {
+        return next_ > ring_.size() ? next_ - ring_.size() : 0;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<change_event<T>> ring_;
+    uint64_t next_ = 0;
+};
+
+/**
+ * @brief Позиция потребителя change_feed
+ *
+ * Пример цикла потребителя производного представления:
+ * @code
+ *   std::vector<change_event<int>> events;
+ *   if (!consumer.poll(events, 256)) {
+ *       consumer.resync();                    // в потоке владельца списка
+ *       view.rebuild(list.lower_bound(from), list.end());
+ *   }
+ * @endcode
+ */
+template<typename T>
+class change_consumer {
+public:
+    /// Начинает чтение с событий, опубликованных после создания
+    explicit change_consumer(const change_feed<T>& feed)
+        : feed_(&feed), position_(feed.next_sequence()) {}
+
+    /**
+     * @brief Добавляет в out до max новых событий
+     * @return false при переполнении: нужна resync()
+     */
+    bool poll(std::vector<change_event<T>>& out, size_t max = static_cast<size_t>(-1)) {
+        return feed_->read(position_, out, max);
+    }
+
+    /**
+     * @brief Переносит позицию в конец журнала
+     *
+     * После вызова потребитель должен перечитать контейнер: события до
+     * новой позиции в нем уже отражены.
+     */
+    void resync() {
+        position_ = feed_->next_sequence();
+    }
+
+    /// Номер следующего непрочитанного события
+    uint64_t position() const noexcept {
+        return position_;
+    }
+
+    /// Число опубликованных, но не прочитанных событий
+    uint64_t lag() const {
+        return feed_->next_sequence() - position_;
+    }
+
+private:
+    const change_feed<T>* feed_;
+    uint64_t position_;
+};
+
+/**
+ * @brief Публикует вставки, удаления и очистки списка в change_feed
+ *
+ * Каждое изменение содержимого добавляет в feed событие с копией
+ * значения, и потребители поддерживают производные представления
+ * инкрементально. Журнал должен пережить публикатора, а публикатор
+ * отключается от списка сам. Копирование списка публикатора не
+ * переносит, перемещение и swap переносят вместе с содержимым.
+ */
+template<typename List>
+class change_publisher : public skip_list_observer<List> {
+public:
+    using value_type = typename List::value_type;
+
+    change_publisher(List& list, change_feed<value_type>& feed) : feed_(&feed) {
+        list.add_observer(this);
+    }
+
+    change_publisher(const change_publisher&) = delete;
+    change_publisher& operator=(const change_publisher&) = delete;
+
+    ~change_publisher() {
+        if (list_) {
+            list_->remove_observer(this);
+        }
+    }
+
+    void on_attach(List& list) override {
+        list_ = &list;
+    }
+
+    void on_insert(typename List::iterator inserted) override {
+        feed_->publish(change_op::insert, *inserted);
+    }
+
+    void on_erase(typename List::iterator erased) override {
+        feed_->publish(change_op::erase, *erased);
+    }
+
+    void on_clear() noexcept override {
+        feed_->publish_clear();
+    }
+
+    void on_detach() noexcept override {
+        list_ = nullptr;
+    }
+
+private:
+    change_feed<value_type>* feed_;
+    List* list_ = nullptr;
+};
+
+} // namespace stl
+
+#endif // CHANGE_FEED_HPP
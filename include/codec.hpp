@@ -0,0 +1,240 @@
+/**
+ * @file codec.hpp
+ * @brief Кодеки отсортированных диапазонов значений для выгрузки из памяти
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef CODEC_HPP
+#define CODEC_HPP
+
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace stl {
+
+namespace detail {
+
+inline void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+inline uint64_t get_varint(std::string_view bytes, size_t& pos) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (pos >= bytes.size()) {
+            throw std::runtime_error("Truncated varint");
+        }
+        auto byte = static_cast<unsigned char>(bytes[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Malformed varint");
+}
+
+/**
+ * @brief Простое сжатие LZ77
+ *
+ * Формат: исходный размер, затем последовательности "число литералов,
+ * литералы, длина совпадения, смещение" в varint; последняя
+ * последовательность состоит только из литералов. Совпадения ищутся по
+ * хеш-таблице четырехбайтовых префиксов.
+ */
+inline std::string lz_compress(std::string_view in) {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr unsigned HASH_BITS = 12;
+    constexpr uint32_t NONE = UINT32_MAX;
+
+    auto load32 = [&in](size_t pos) {
+        uint32_t value;
+        std::memcpy(&value, in.data() + pos, sizeof(value));
+        return value;
+    };
+
+    std::string out;
+    put_varint(out, in.size());
+    std::vector<uint32_t> table(size_t{1} << HASH_BITS, NONE);
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + MIN_MATCH <= in.size()) {
+        uint32_t sequence = load32(pos);
+        uint32_t& slot = table[(sequence * 2654435761u) >> (32 - HASH_BITS)];
+        uint32_t candidate = slot;
+        slot = static_cast<uint32_t>(pos);
+        if (candidate == NONE || load32(candidate) != sequence) {
+            ++pos;
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (pos + length < in.size() && in[candidate + length] == in[pos + length]) {
+            ++length;
+        }
+        put_varint(out, pos - anchor);
+        out.append(in.substr(anchor, pos - anchor));
+        put_varint(out, length);
+        put_varint(out, pos - candidate);
+        pos += length;
+        anchor = pos;
+    }
+    put_varint(out, in.size() - anchor);
+    out.append(in.substr(anchor));
+    return out;
+}
+
+inline std::string lz_decompress(std::string_view in) {
+    size_t pos = 0;
+    uint64_t size = get_varint(in, pos);
+    std::string out;
+    out.reserve(size);
+    while (out.size() < size) {
+        uint64_t literals = get_varint(in, pos);
+        if (literals > in.size() - pos || literals > size - out.size()) {
+            throw std::runtime_error("Corrupted LZ block");
+        }
+        out.append(in.substr(pos, literals));
+        pos += literals;
+        if (out.size() == size) {
+            break;
+        }
+
+        uint64_t length = get_varint(in, pos);
+        uint64_t offset = get_varint(in, pos);
+        if (offset == 0 || offset > out.size() || length > size - out.size()) {
+            throw std::runtime_error("Corrupted LZ block");
+        }
+        // Совпадение может перекрывать сам себя, поэтому копируем по байту
+        size_t from = out.size() - offset;
+        for (uint64_t i = 0; i < length; ++i) {
+            out.push_back(out[from + i]);
+        }
+    }
+    return out;
+}
+
+} // namespace detail
+
+/**
+ * @brief Кодек побайтового копирования для тривиально копируемых T
+ *
+ * Кодек - тип со статическими функциями
+ *   std::string encode(const std::vector<T>&) и
+ *   std::vector<T> decode(std::string_view);
+ * encode получает значения в порядке возрастания.
+ */
+template<typename T>
+struct raw_codec {
+    static_assert(std::is_trivially_copyable_v<T>, "raw_codec requires trivially copyable T");
+
+    static std::string encode(const std::vector<T>& values) {
+        std::string out(values.size() * sizeof(T), '\0');
+        if (!values.empty()) {
+            std::memcpy(out.data(), values.data(), out.size());
+        }
+        return out;
+    }
+
+    static std::vector<T> decode(std::string_view bytes) {
+        if (bytes.size() % sizeof(T) != 0) {
+            throw std::runtime_error("Corrupted raw block");
+        }
+        std::vector<T> values(bytes.size() / sizeof(T));
+        if (!values.empty()) {
+            std::memcpy(values.data(), bytes.data(), bytes.size());
+        }
+        return values;
+    }
+};
+
+/**
+ * @brief Кодек строк: длина в varint и байты строки
+ */
+struct string_codec {
+    static std::string encode(const std::vector<std::string>& values) {
+        std::string out;
+        for (const auto& value : values) {
+            detail::put_varint(out, value.size());
+            out.append(value);
+        }
+        return out;
+    }
+
+    static std::vector<std::string> decode(std::string_view bytes) {
+        std::vector<std::string> values;
+        size_t pos = 0;
+        while (pos < bytes.size()) {
+            uint64_t length = detail::get_varint(bytes, pos);
+            if (length > bytes.size() - pos) {
+                throw std::runtime_error("Corrupted string block");
+            }
+            values.emplace_back(bytes.substr(pos, length));
+            pos += length;
+        }
+        return values;
+    }
+};
+
+/**
+ * @brief Кодек целых: разности соседних значений в zigzag-varint
+ *
+ * Отсортированные близкие ключи занимают по одному-два байта.
+ */
+template<std::integral T>
+struct delta_varint_codec {
+    static std::string encode(const std::vector<T>& values) {
+        std::string out;
+        uint64_t previous = 0;
+        for (T value : values) {
+            auto delta = static_cast<int64_t>(static_cast<uint64_t>(value) - previous);
+            detail::put_varint(out, (static_cast<uint64_t>(delta) << 1) ^
+                                        static_cast<uint64_t>(delta >> 63));
+            previous = static_cast<uint64_t>(value);
+        }
+        return out;
+    }
+
+    static std::vector<T> decode(std::string_view bytes) {
+        std::vector<T> values;
+        uint64_t previous = 0;
+        size_t pos = 0;
+        while (pos < bytes.size()) {
+            uint64_t zigzag = detail::get_varint(bytes, pos);
+            uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+            previous += delta;
+            values.push_back(static_cast<T>(previous));
+        }
+        return values;
+    }
+};
+
+/**
+ * @brief Сжимает блоки кодека Inner алгоритмом LZ77
+ */
+template<typename Inner>
+struct lz_codec {
+    template<typename T>
+    static std::string encode(const std::vector<T>& values) {
+        return detail::lz_compress(Inner::encode(values));
+    }
+
+    static auto decode(std::string_view bytes) {
+        return Inner::decode(detail::lz_decompress(bytes));
+    }
+};
+
+} // namespace stl
+
+#endif // CODEC_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file concurrency_stats.hpp
+ * @brief Счетчики конкуренции для конкурентных списков с пропусками
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef CONCURRENCY_STATS_HPP
+#define CONCURRENCY_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace stl {
+
+/**
+ * @brief Гистограмма длительностей ожидания по степеням двойки
+ *
+ * Корзина i считает ожидания длительностью [2^(i-1), 2^i) наносекунд,
+ * корзина 0 - ожидания без блокировки.
+ */
+class wait_histogram {
+public:
+    static constexpr size_t BUCKETS = 40;
+
+    using counts = std::array<uint64_t, BUCKETS>;
+
+    void record(std::chrono::nanoseconds wait) noexcept {
+        uint64_t ns = wait.count() > 0 ? static_cast<uint64_t>(wait.count()) : 0;
+        size_t bucket = std::bit_width(ns);
+        buckets_[bucket < BUCKETS ? bucket : BUCKETS - 1].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    counts read() const noexcept {
+        counts result{};
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            result[i] = buckets_[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+};
+
+/**
+ * @brief Счетчики неудачных CAS, перезапусков и ожиданий
+ *
+ * Обновляются relaxed-инкрементами на путях неудачи и читаются в любой
+ * момент без остановки структуры; снимок не атомарен, но каждый счетчик
+ * монотонен. Уровень неудачного CAS - высота башни узла, чью ссылку
+ * пытались изменить; неудачи на голове списка считаются отдельно,
+ * что позволяет отличить горячую голову от горячего диапазона ключей.
+ */
+class concurrency_stats {
+public:
+    static constexpr size_t LEVELS = 32;
+
+    struct snapshot {
+        std::array<uint64_t, LEVELS> cas_failures{};
+        uint64_t head_cas_failures = 0;
+        uint64_t restarts = 0;
+        uint64_t scan_retries = 0;
+        wait_histogram::counts lock_wait{};
+        wait_histogram::counts drain_wait{};
+        size_t reclamation_backlog = 0;
+        uint64_t epoch = 0;
+
+        uint64_t total_cas_failures() const noexcept {
+            uint64_t total = head_cas_failures;
+            for (uint64_t count : cas_failures) {
+                total += count;
+            }
+            return total;
+        }
+    };
+
+    void cas_failure(size_t level) noexcept {
+        cas_failures_[level < LEVELS ? level : LEVELS - 1].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void head_cas_failure() noexcept {
+        head_cas_failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Поиск начат заново из-за параллельного изменения
+    void restart() noexcept {
+        restarts_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Оптимистичное сканирование не прошло проверку версий
+    void scan_retry() noexcept {
+        scan_retries_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void lock_wait(std::chrono::nanoseconds wait) noexcept {
+        lock_wait_.record(wait);
+    }
+
+    /// Ожидание ухода читателей со старой копии или эпохи
+    void drain_wait(std::chrono::nanoseconds wait) noexcept {
+        drain_wait_.record(wait);
+    }
+
+    snapshot read() const noexcept {
+        snapshot result;
+        for (size_t i = 0; i < LEVELS; ++i) {
+            result.cas_failures[i] = cas_failures_[i].load(std::memory_order_relaxed);
+        }
+        result.head_cas_failures = head_cas_failures_.load(std::memory_order_relaxed);
+        result.restarts = restarts_.load(std::memory_order_relaxed);
+        result.scan_retries = scan_retries_.load(std::memory_order_relaxed);
+        result.lock_wait = lock_wait_.read();
+        result.drain_wait = drain_wait_.read();
+        return result;
+    }
+
+private:
+    // Отдельная кэш-линия, чтобы счетчики не делили ее с полями списка
+    alignas(64) std::array<std::atomic<uint64_t>, LEVELS> cas_failures_{};
+    std::atomic<uint64_t> head_cas_failures_{0};
+    std::atomic<uint64_t> restarts_{0};
+    std::atomic<uint64_t> scan_retries_{0};
+    wait_histogram lock_wait_;
+    wait_histogram drain_wait_;
+};
+
+} // namespace stl
+
+#endif // CONCURRENCY_STATS_HPP
@@ -0,0 +1,277 @@
+/**
+ * @file dump_file.hpp
+ * @brief Файл отсортированного дампа: фоновая запись блоков и чтение
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef DUMP_FILE_HPP
+#define DUMP_FILE_HPP
+
+#include "codec.hpp"
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace stl {
+
+namespace detail {
+
+/**
+ * @brief Пишет блоки дампа в файл из фонового потока
+ *
+ * Блоки пишутся во временный файл path.tmp, каждый с длиной в varint.
+ * push_values() передает значения некодированными: Codec::encode тоже
+ * выполняется фоновым потоком.
+ * finish() дожидается записи, выполняет fdatasync и переименовывает файл
+ * в path, так что по пути path никогда не лежит недописанный дамп.
+ * Временным файлам, которым не нужно переживать сбой (серии
+ * external_sorter), fdatasync отключается флагом durable.
+ * Ошибка записи запоминается потоком и выбрасывается из finish().
+ * Уничтожение без finish() удаляет временный файл.
+ */
+class dump_writer {
+public:
+    explicit dump_writer(std::string path, bool durable = true)
+        : path_(std::move(path)), tmp_path_(path_ + ".tmp"), durable_(durable) {
+        fd_ = ::open(tmp_path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot open dump file '" + tmp_path_ +
+                                     "': " + std::strerror(errno));
+        }
+        worker_ = std::thread([this] { worker_loop(); });
+    }
+
+    dump_writer(const dump_writer&) = delete;
+    dump_writer& operator=(const dump_writer&) = delete;
+
+    ~dump_writer() {
+        if (worker_.joinable()) {
+            close_queue();
+            worker_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            ::unlink(tmp_path_.c_str());
+        }
+    }
+
+    void push(std::string block) {
+        enqueue([block = std::move(block)]() mutable { return std::move(block); });
+    }
+
+    /// Ставит в очередь блок, который поток записи закодирует Codec
+    template<typename Codec, typename T>
+    void push_values(std::vector<T> values) {
+        enqueue([values = std::move(values)] { return std::string(Codec::encode(values)); });
+    }
+
+    /// Дописывает очередь и публикует файл под именем path
+    void finish() {
+        close_queue();
+        worker_.join();
+        if (!error_ && durable_ && ::fdatasync(fd_) != 0) {
+            error_ = std::make_exception_ptr(std::runtime_error(
+                "Cannot sync dump file '" + tmp_path_ + "': " + std::strerror(errno)));
+        }
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        ::close(fd_);
+        fd_ = -1;
+        if (::rename(tmp_path_.c_str(), path_.c_str()) != 0) {
+            int saved = errno;
+            ::unlink(tmp_path_.c_str());
+            throw std::runtime_error("Cannot publish dump file '" + path_ +
+                                     "': " + std::strerror(saved));
+        }
+    }
+
+private:
+    void enqueue(std::function<std::string()> block) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocks_.push_back(std::move(block));
+        }
+        cv_.notify_one();
+    }
+
+    void close_queue() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        cv_.notify_one();
+    }
+
+    void worker_loop() {
+        std::string frame;
+        while (true) {
+            std::function<std::string()> block;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return closed_ || !blocks_.empty(); });
+                if (blocks_.empty()) {
+                    return;
+                }
+                block = std::move(blocks_.front());
+                blocks_.pop_front();
+            }
+            if (error_) {
+                continue;
+            }
+            try {
+                std::string bytes = block();
+                frame.clear();
+                put_varint(frame, bytes.size());
+                frame.append(bytes);
+            } catch (...) {
+                error_ = std::current_exception();
+                continue;
+            }
+            write_all(frame);
+        }
+    }
+
+    void write_all(std::string_view bytes) {
+        while (!bytes.empty()) {
+            ssize_t n = ::write(fd_, bytes.data(), bytes.size());
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                error_ = std::make_exception_ptr(std::runtime_error(
+                    "Cannot write dump file '" + tmp_path_ + "': " + std::strerror(errno)));
+                return;
+            }
+            bytes.remove_prefix(static_cast<size_t>(n));
+        }
+    }
+
+    std::string path_;
+    std::string tmp_path_;
+    bool durable_;
+    int fd_ = -1;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<std::string()>> blocks_;
+    bool closed_ = false;
+    std::exception_ptr error_;         ///< пишет только поток записи до join
+    std::thread worker_;
+};
+
+/**
+ * @brief Читает файл dump_writer по одному блоку
+ *
+ * В памяти находится только текущий блок, поэтому так читаются файлы
+ * больше памяти (см. external_sorter).
+ */
+template<typename T, typename Codec>
+class dump_reader {
+public:
+    explicit dump_reader(const std::string& path) : path_(path), in_(path, std::ios::binary) {
+        if (!in_) {
+            throw std::runtime_error("Cannot open dump file '" + path_ + "'");
+        }
+    }
+
+    /// Следующее значение или nullptr в конце файла; указатель действителен
+    /// до следующего вызова
+    T* next() {
+        while (pos_ == block_.size()) {
+            if (!read_block()) {
+                return nullptr;
+            }
+        }
+        return &block_[pos_++];
+    }
+
+private:
+    bool read_block() {
+        uint64_t length = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            int byte = in_.get();
+            if (byte == std::char_traits<char>::eof()) {
+                if (shift == 0) {
+                    return false;
+                }
+                throw std::runtime_error("Truncated dump file '" + path_ + "'");
+            }
+            if (shift >= 64) {
+                throw std::runtime_error("Malformed dump file '" + path_ + "'");
+            }
+            length |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        bytes_.resize(length);
+        if (!in_.read(bytes_.data(), static_cast<std::streamsize>(length))) {
+            throw std::runtime_error("Truncated dump file '" + path_ + "'");
+        }
+        block_ = Codec::decode(bytes_);
+        pos_ = 0;
+        return true;
+    }
+
+    std::string path_;
+    std::ifstream in_;
+    std::string bytes_;
+    std::vector<T> block_;
+    size_t pos_ = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief Вызывает f(value) для значений дампа в порядке записи
+ *
+ * Codec должен совпадать с кодеком, которым дамп записан
+ * (см. skip_list_dump).
+ *
+ * @throws std::runtime_error если файл не читается или поврежден
+ */
+template<typename Codec, typename F>
+void read_dump(const std::string& path, F&& f) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open dump file '" + path + "'");
+    }
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string_view view(bytes);
+    size_t pos = 0;
+    while (pos < view.size()) {
+        uint64_t length = detail::get_varint(view, pos);
+        if (length > view.size() - pos) {
+            throw std::runtime_error("Truncated dump file '" + path + "'");
+        }
+        for (auto& value : Codec::decode(view.substr(pos, length))) {
+            f(std::move(value));
+        }
+        pos += length;
+    }
+}
+
+} // namespace stl
+
+#endif // DUMP_FILE_HPP
@@ -0,0 +1,283 @@
+/**
+ * @file epoch_reclaimer.hpp
+ * @brief Эпохальное отложенное освобождение памяти для конкурентных списков с пропусками
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef EPOCH_RECLAIMER_HPP
+#define EPOCH_RECLAIMER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+namespace detail {
+
+/**
+ * @brief Раздает потокам номера слотов
+ *
+ * Номер закрепляется за потоком при первом обращении и возвращается
+ * в пул при завершении потока, поэтому номера не превышают наибольшего
+ * числа одновременно живых потоков.
+ */
+class thread_registry {
+public:
+    static thread_registry& instance() {
+        static thread_registry registry;
+        return registry;
+    }
+
+    size_t acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            size_t index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        return next_++;
+    }
+
+    void release(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(index);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<size_t> free_;
+    size_t next_ = 0;
+};
+
+struct thread_slot_owner {
+    size_t index;
+
+    thread_slot_owner() : index(thread_registry::instance().acquire()) {}
+    ~thread_slot_owner() { thread_registry::instance().release(index); }
+};
+
+inline size_t thread_index() {
+    thread_local thread_slot_owner owner;
+    return owner.index;
+}
+
+} // namespace detail
+
+/**
+ * @brief Освобождение узлов по эпохам (EBR)
+ *
+ * Читатель закрепляет текущую эпоху в собственном слоте на время обхода,
+ * писатель откладывает удаление отсоединенных узлов через retire().
+ * Узел, выведенный из структуры в эпоху e, освобождается, когда глобальная
+ * эпоха достигает e + 2: к этому моменту ни один читатель не может его видеть.
+ *
+ * Слоты лежат блоками по SLOT_CHUNK, связанными атомарными указателями;
+ * поток с номером за последним блоком добавляет новый при первом
+ * закреплении. Число потоков не ограничено, а обход блоков при
+ * продвижении эпохи пропорционален наибольшему числу живых потоков.
+ */
+class epoch_reclaimer {
+    struct alignas(64) slot {
+        std::atomic<uint64_t> epoch{0};
+        size_t depth = 0;
+    };
+
+    static constexpr size_t SLOT_CHUNK = 64;
+
+    struct slot_chunk {
+        slot slots[SLOT_CHUNK];
+        std::atomic<slot_chunk*> next{nullptr};
+    };
+
+    struct retired_node {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    static constexpr uint64_t IDLE = 0;
+    static constexpr size_t RECLAIM_THRESHOLD = 64;
+
+public:
+    /**
+     * @brief RAII-закрепление эпохи текущим потоком
+     *
+     * Допускает вложенность; копия закрепляет эпоху повторно.
+     * Не должна передаваться между потоками.
+     */
+    class guard {
+    public:
+        guard() = default;
+
+        explicit guard(epoch_reclaimer& owner) : owner_(&owner) {
+            slot_ = owner_->enter();
+        }
+
+        guard(const guard& other) : owner_(other.owner_) {
+            if (owner_) {
+                slot_ = owner_->enter();
+            }
+        }
+
+        guard(guard&& other) noexcept : owner_(other.owner_), slot_(other.slot_) {
+            other.owner_ = nullptr;
+            other.slot_ = nullptr;
+        }
+
+        guard& operator=(guard other) noexcept {
+            std::swap(owner_, other.owner_);
+            std::swap(slot_, other.slot_);
+            return *this;
+        }
+
+        ~guard() {
+            if (owner_) {
+                owner_->leave(slot_);
+            }
+        }
+
+    private:
+        epoch_reclaimer* owner_ = nullptr;
+        slot* slot_ = nullptr;
+    };
+
+    epoch_reclaimer() : slots_(std::make_unique<slot_chunk>()) {}
+
+    epoch_reclaimer(const epoch_reclaimer&) = delete;
+    epoch_reclaimer& operator=(const epoch_reclaimer&) = delete;
+
+    ~epoch_reclaimer() {
+        for (auto& node : retired_) {
+            node.deleter(node.ptr);
+        }
+        slot_chunk* chunk = slots_->next.load(std::memory_order_relaxed);
+        while (chunk) {
+            slot_chunk* next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    guard pin() {
+        return guard(*this);
+    }
+
+    void retire(void* ptr, void (*deleter)(void*)) {
+        bool reclaim_now;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            retired_.push_back({ptr, deleter, global_.load(std::memory_order_acquire)});
+            pending_.store(retired_.size(), std::memory_order_relaxed);
+            reclaim_now = retired_.size() % RECLAIM_THRESHOLD == 0;
+        }
+        if (reclaim_now) {
+            reclaim();
+        }
+    }
+
+    template<typename U>
+    void retire(U* ptr) {
+        retire(ptr, [](void* p) { delete static_cast<U*>(p); });
+    }
+
+    /**
+     * @brief Пытается продвинуть эпоху и освобождает устаревшие узлы
+     * @return Количество освобожденных узлов
+     */
+    size_t reclaim() {
+        std::vector<retired_node> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Два шага подряд: узлы, выведенные в текущей эпохе, освобождаются
+            // за один вызов, если ни один читатель не закреплен
+            try_advance();
+            try_advance();
+            uint64_t current = global_.load(std::memory_order_acquire);
+            auto keep = std::partition(retired_.begin(), retired_.end(),
+                [current](const retired_node& node) { return node.epoch + 2 > current; });
+            ready.assign(keep, retired_.end());
+            retired_.erase(keep, retired_.end());
+            pending_.store(retired_.size(), std::memory_order_relaxed);
+        }
+        for (auto& node : ready) {
+            node.deleter(node.ptr);
+        }
+        return ready.size();
+    }
+
+    /// Количество узлов, ожидающих освобождения
+    size_t pending() const noexcept {
+        return pending_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t epoch() const noexcept {
+        return global_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Слот потока index; недостающие блоки добавляются CAS без блокировки
+    slot* slot_for(size_t index) {
+        slot_chunk* chunk = slots_.get();
+        for (; index >= SLOT_CHUNK; index -= SLOT_CHUNK) {
+            slot_chunk* next = chunk->next.load(std::memory_order_acquire);
+            if (!next) {
+                auto fresh = std::make_unique<slot_chunk>();
+                if (chunk->next.compare_exchange_strong(next, fresh.get(),
+                                                        std::memory_order_acq_rel,
+                                                        std::memory_order_acquire)) {
+                    next = fresh.release();
+                }
+            }
+            chunk = next;
+        }
+        return &chunk->slots[index];
+    }
+
+    slot* enter() {
+        slot* s = slot_for(detail::thread_index());
+        if (s->depth++ == 0) {
+            s->epoch.store(global_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return s;
+    }
+
+    void leave(slot* s) {
+        if (--s->depth == 0) {
+            s->epoch.store(IDLE, std::memory_order_release);
+        }
+    }
+
+    void try_advance() {
+        uint64_t current = global_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (const slot_chunk* chunk = slots_.get(); chunk;
+             chunk = chunk->next.load(std::memory_order_acquire)) {
+            for (const slot& s : chunk->slots) {
+                uint64_t local = s.epoch.load(std::memory_order_acquire);
+                if (local != IDLE && local != current) {
+                    return;
+                }
+            }
+        }
+        global_.store(current + 1, std::memory_order_release);
+    }
+
+    std::atomic<uint64_t> global_{1};
+    std::unique_ptr<slot_chunk> slots_;
+    std::mutex mutex_;
+    std::vector<retired_node> retired_;
+    std::atomic<size_t> pending_{0};
+};
+
+} // namespace stl
+
+#endif // EPOCH_RECLAIMER_HPP
@@ -0,0 +1,300 @@
+/**
+ * @file external_sort.hpp
+ * @brief Внешняя сортировка: серии замещающим выбором на skip_list и k-путевое слияние
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+
+#include "codec.hpp"
+#include "dump_file.hpp"
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace stl {
+
+/**
+ * @brief Параметры external_sorter
+ */
+struct external_sort_options {
+    std::string temp_dir;              ///< каталог файлов серий
+    size_t memory_elements = 1 << 20;  ///< элементов в памяти при формировании серий
+    size_t merge_fanout = 64;          ///< серий в одном слиянии
+};
+
+/**
+ * @brief Сортирует последовательность, не помещающуюся в память
+ *
+ * push() формирует серии замещающим выбором: skip_list из не более
+ * memory_elements элементов отдает наименьший элемент текущей серии через
+ * front()/pop_front() в файл серии, а пришедший элемент попадает в
+ * текущую серию, если он не меньше последнего записанного, иначе - в
+ * следующую. На случайных данных серии получаются примерно вдвое длиннее
+ * памяти, на отсортированных - одна серия. Серии пишутся в temp_dir
+ * фоновым потоком (см. dump_file.hpp) блоками Codec, без fdatasync:
+ * после сбоя они не нужны.
+ *
+ * finish() сливает серии k-путевым слиянием по merge_fanout за проход;
+ * слияние тоже ведет skip_list из голов серий. Равные элементы
+ * сохраняются все.
+ */
+template<typename T, typename Compare = std::less<T>, typename Codec = raw_codec<T>>
+class external_sorter {
+    // Номер серии впереди: элементы следующей серии не мешают текущей.
+    // tag различает равные значения
+    struct run_entry {
+        uint64_t run = 0;
+        T value{};
+        uint64_t tag = 0;
+    };
+
+    struct run_less {
+        Compare comp;
+
+        bool operator()(const run_entry& a, const run_entry& b) const {
+            if (a.run != b.run) {
+                return a.run < b.run;
+            }
+            if (comp(a.value, b.value)) {
+                return true;
+            }
+            if (comp(b.value, a.value)) {
+                return false;
+            }
+            return a.tag < b.tag;
+        }
+    };
+
+    struct merge_entry {
+        T value{};
+        size_t source = 0;
+    };
+
+    struct merge_less {
+        Compare comp;
+
+        bool operator()(const merge_entry& a, const merge_entry& b) const {
+            if (comp(a.value, b.value)) {
+                return true;
+            }
+            if (comp(b.value, a.value)) {
+                return false;
+            }
+            return a.source < b.source;
+        }
+    };
+
+    using reader = detail::dump_reader<T, Codec>;
+
+    static constexpr size_t BLOCK_VALUES = 4096;
+
+public:
+    explicit external_sorter(external_sort_options options, const Compare& comp = Compare())
+        : options_(std::move(options)), comp_(comp), heap_(run_less{comp}),
+          prefix_("sort-" + std::to_string(::getpid()) + "-" + std::to_string(next_instance()) +
+                  "-") {
+        if (options_.memory_elements == 0 || options_.merge_fanout < 2) {
+            throw std::out_of_range("External sort needs memory and a merge fanout of at least 2");
+        }
+        std::filesystem::create_directories(options_.temp_dir);
+    }
+
+    external_sorter(const external_sorter&) = delete;
+    external_sorter& operator=(const external_sorter&) = delete;
+
+    /// Удаляет оставшиеся файлы серий, в том числе недоделанного прохода слияния
+    ~external_sorter() {
+        writer_.reset();
+        for (const auto* paths : {&runs_, &merged_}) {
+            for (const auto& path : *paths) {
+                std::error_code ignored;
+                std::filesystem::remove(path, ignored);
+            }
+        }
+    }
+
+    void push(const T& value) {
+        if (finished_) {
+            throw std::runtime_error("external_sorter::push after finish");
+        }
+        if (heap_.size() == options_.memory_elements) {
+            emit_front();
+        }
+        uint64_t run = current_run_;
+        if (last_ && comp_(value, *last_)) {
+            ++run;
+        }
+        heap_.insert(run_entry{run, value, next_tag_++});
+        ++total_;
+    }
+
+    /**
+     * @brief Дописывает серии, сливает их и вызывает out(value) по возрастанию
+     */
+    template<typename F>
+    void finish(F&& out) {
+        if (finished_) {
+            throw std::runtime_error("external_sorter::finish called twice");
+        }
+        finished_ = true;
+        while (!heap_.empty()) {
+            emit_front();
+        }
+        close_run();
+        initial_runs_ = runs_.size();
+
+        while (runs_.size() > options_.merge_fanout) {
+            // Готовые серии прохода сразу попадают в merged_, чтобы исключение
+            // посреди прохода не оставило их на диске
+            for (size_t first = 0; first < runs_.size(); first += options_.merge_fanout) {
+                size_t last = std::min(runs_.size(), first + options_.merge_fanout);
+                std::string path = run_path();
+                detail::dump_writer writer(path, false);
+                std::vector<T> block;
+                merge(first, last, [&](const T& value) {
+                    block.push_back(value);
+                    if (block.size() == BLOCK_VALUES) {
+                        writer.push(Codec::encode(block));
+                        block.clear();
+                    }
+                });
+                if (!block.empty()) {
+                    writer.push(Codec::encode(block));
+                }
+                writer.finish();
+                merged_.push_back(std::move(path));
+            }
+            runs_.swap(merged_);
+            while (!merged_.empty()) {
+                std::filesystem::remove(merged_.back());
+                merged_.pop_back();
+            }
+            ++merge_passes_;
+        }
+        merge(0, runs_.size(), out);
+        ++merge_passes_;
+    }
+
+    /// Элементов, переданных push()
+    size_t size() const noexcept {
+        return total_;
+    }
+
+    /// Серий, сформированных замещающим выбором
+    size_t initial_runs() const noexcept {
+        return finished_ ? initial_runs_ : runs_.size() + (writer_ ? 1 : 0);
+    }
+
+    /// Проходов слияния, включая финальный
+    size_t merge_passes() const noexcept {
+        return merge_passes_;
+    }
+
+private:
+    static uint64_t next_instance() {
+        static std::atomic<uint64_t> counter{0};
+        return counter++;
+    }
+
+    std::string run_path() {
+        return (std::filesystem::path(options_.temp_dir) /
+                (prefix_ + std::to_string(next_file_++) + ".run"))
+            .string();
+    }
+
+    // Переносит наименьший элемент текущей серии в ее файл
+    void emit_front() {
+        const run_entry& front = heap_.front();
+        if (writer_ && front.run != current_run_) {
+            close_run();
+        }
+        if (!writer_) {
+            current_run_ = front.run;
+            writer_path_ = run_path();
+            writer_ = std::make_unique<detail::dump_writer>(writer_path_, false);
+        }
+        block_.push_back(front.value);
+        last_ = front.value;
+        heap_.pop_front();
+        if (block_.size() == BLOCK_VALUES) {
+            writer_->push(Codec::encode(block_));
+            block_.clear();
+        }
+    }
+
+    void close_run() {
+        if (!writer_) {
+            return;
+        }
+        if (!block_.empty()) {
+            writer_->push(Codec::encode(block_));
+            block_.clear();
+        }
+        writer_->finish();
+        writer_.reset();
+        runs_.push_back(std::move(writer_path_));
+        // Новая серия открывается первым элементом без ограничения снизу
+        last_.reset();
+    }
+
+    // Сливает серии [first, last) в out
+    template<typename F>
+    void merge(size_t first, size_t last, F&& out) {
+        std::vector<std::unique_ptr<reader>> sources;
+        skip_list<merge_entry, merge_less> heads(merge_less{comp_});
+        for (size_t i = first; i < last; ++i) {
+            sources.push_back(std::make_unique<reader>(runs_[i]));
+            if (T* value = sources.back()->next()) {
+                heads.insert(merge_entry{std::move(*value), sources.size() - 1});
+            }
+        }
+        while (!heads.empty()) {
+            size_t source = heads.front().source;
+            out(heads.front().value);
+            heads.pop_front();
+            if (T* value = sources[source]->next()) {
+                heads.insert(merge_entry{std::move(*value), source});
+            }
+        }
+    }
+
+    external_sort_options options_;
+    Compare comp_;
+    skip_list<run_entry, run_less> heap_;
+    std::string prefix_;
+    std::vector<std::string> runs_;
+    std::vector<std::string> merged_;  ///< готовые серии текущего прохода слияния
+    std::unique_ptr<detail::dump_writer> writer_;
+    std::string writer_path_;
+    std::vector<T> block_;
+    std::optional<T> last_;
+    uint64_t current_run_ = 0;
+    uint64_t next_tag_ = 0;
+    uint64_t next_file_ = 0;
+    size_t total_ = 0;
+    size_t initial_runs_ = 0;
+    size_t merge_passes_ = 0;
+    bool finished_ = false;
+};
+
+} // namespace stl
+
+#endif // EXTERNAL_SORT_HPP
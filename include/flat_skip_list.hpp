@@ -0,0 +1,109 @@
+/**
+ * @file flat_skip_list.hpp
+ * @brief Список с пропусками в одном буфере памяти с копированием через memcpy
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef FLAT_SKIP_LIST_HPP
+#define FLAT_SKIP_LIST_HPP
+
+#include "offset_skip_list.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace stl {
+
+/**
+ * @brief Хранилище offset_skip_list в одном буфере кучи процесса
+ */
+class heap_storage {
+public:
+    heap_storage() = default;
+
+    heap_storage(const heap_storage&) = delete;
+    heap_storage& operator=(const heap_storage&) = delete;
+
+    heap_storage(heap_storage&& other) noexcept
+        : data_(std::move(other.data_)), capacity_(std::exchange(other.capacity_, 0)) {}
+
+    heap_storage& operator=(heap_storage&& other) noexcept {
+        data_ = std::move(other.data_);
+        capacity_ = std::exchange(other.capacity_, 0);
+        return *this;
+    }
+
+    char* data() noexcept {
+        return data_.get();
+    }
+
+    const char* data() const noexcept {
+        return data_.get();
+    }
+
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    void reserve(size_t bytes) {
+        if (bytes <= capacity_) {
+            return;
+        }
+        auto fresh = std::make_unique_for_overwrite<char[]>(bytes);
+        if (capacity_) {
+            std::memcpy(fresh.get(), data_.get(), capacity_);
+        }
+        std::memset(fresh.get() + capacity_, 0, bytes - capacity_);
+        data_ = std::move(fresh);
+        capacity_ = bytes;
+    }
+
+    void flush() noexcept {}
+
+private:
+    std::unique_ptr<char[]> data_;
+    size_t capacity_ = 0;
+};
+
+/**
+ * @brief Упорядоченное множество, копируемое одним memcpy
+ *
+ * В отличие от skip_list, копия которого вставляет элементы по одному и
+ * выделяет узел на каждый, узлы здесь лежат в одном буфере со ссылками-
+ * смещениями, и копия переносит занятую часть буфера целиком без
+ * исправления ссылок. Подходит для частого клонирования состояния.
+ * Копию можно снять и с persistent_skip_list того же T и Compare.
+ */
+template<typename T, typename Compare = std::less<T>>
+class flat_skip_list : public offset_skip_list<T, Compare, heap_storage> {
+    using base = offset_skip_list<T, Compare, heap_storage>;
+
+public:
+    explicit flat_skip_list(const Compare& comp = Compare()) : base(heap_storage(), comp) {}
+
+    flat_skip_list(std::initializer_list<T> init, const Compare& comp = Compare())
+        : flat_skip_list(comp) {
+        for (const auto& value : init) {
+            this->insert(value);
+        }
+    }
+
+    /// Копирует кучу списка с другим хранилищем
+    template<typename Storage>
+    explicit flat_skip_list(const offset_skip_list<T, Compare, Storage>& other) : base(other) {}
+
+    /// Байт, выделенных под кучу
+    size_t capacity_bytes() const noexcept {
+        return this->storage().capacity();
+    }
+};
+
+} // namespace stl
+
+#endif // FLAT_SKIP_LIST_HPP
@@ -0,0 +1,358 @@
+/**
+ * @file intrusive_skip_list.hpp
+ * @brief Интрузивный список с пропусками: башни встроены в объекты пользователя
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef INTRUSIVE_SKIP_LIST_HPP
+#define INTRUSIVE_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace stl {
+
+/**
+ * @brief Башня узла, встраиваемая в объект пользователя
+ *
+ * Хранит ссылки вперед на всех Levels уровнях и указатель на владельца,
+ * поэтому список переходит от башни к объекту без арифметики смещений.
+ * height = 0 означает, что объект не связан ни с одним списком.
+ */
+template<typename T, size_t Levels = 16>
+struct skip_list_hook {
+    static_assert(Levels > 0 && Levels <= MAX_LEVEL, "Levels must be in [1, MAX_LEVEL]");
+
+    static constexpr size_t LEVELS = Levels;
+
+    std::array<skip_list_hook*, Levels> next{};
+    T* owner = nullptr;
+    size_t height = 0;
+
+    skip_list_hook() = default;
+
+    // Копия объекта не наследует место оригинала в списке
+    skip_list_hook(const skip_list_hook&) noexcept {}
+
+    skip_list_hook& operator=(const skip_list_hook&) noexcept {
+        return *this;
+    }
+
+    bool is_linked() const noexcept {
+        return height != 0;
+    }
+};
+
+/**
+ * @brief Упорядоченное множество объектов, связанных через встроенные башни
+ *
+ * Hook - указатель на член T типа skip_list_hook<T, L>. Список не выделяет
+ * память и не копирует значения: insert связывает башню самого объекта,
+ * erase и unlink лишь разрывают ссылки. Объект должен жить, пока связан,
+ * и не должен менять ключ сравнения. Деструктор и clear() отвязывают все
+ * объекты.
+ */
+template<typename T, auto Hook, typename Compare = std::less<T>>
+class intrusive_skip_list {
+    using hook_type = std::remove_reference_t<decltype(std::declval<T&>().*Hook)>;
+
+    static constexpr size_t LEVELS = hook_type::LEVELS;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_compare = Compare;
+
+    template<bool IsConst>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        basic_iterator() = default;
+        explicit basic_iterator(const hook_type* h) : current_(h) {}
+
+        template<bool C = IsConst, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false>& other) : current_(other.hook()) {}
+
+        reference operator*() const {
+            if (!current_) {
+                throw std::runtime_error("Dereferencing null iterator");
+            }
+            return *current_->owner;
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        basic_iterator& operator++() {
+            if (current_) {
+                current_ = current_->next[0];
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            return current_ == other.current_;
+        }
+
+        bool operator!=(const basic_iterator& other) const {
+            return !(*this == other);
+        }
+
+        const hook_type* hook() const noexcept {
+            return current_;
+        }
+
+    private:
+        const hook_type* current_ = nullptr;
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+private:
+    hook_type head_;
+    size_type size_ = 0;
+    size_t max_height_ = 1;
+    value_compare comp_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+
+public:
+    explicit intrusive_skip_list(const Compare& comp = Compare())
+        : comp_(comp), gen_(std::random_device{}()), dist_(0.0, 1.0) {}
+
+    intrusive_skip_list(const intrusive_skip_list&) = delete;
+    intrusive_skip_list& operator=(const intrusive_skip_list&) = delete;
+
+    // На голову не ссылается ни один узел, поэтому ее достаточно скопировать
+    intrusive_skip_list(intrusive_skip_list&& other) noexcept
+        : size_(other.size_), max_height_(other.max_height_), comp_(std::move(other.comp_)),
+          gen_(std::move(other.gen_)), dist_(std::move(other.dist_)) {
+        head_.next = other.head_.next;
+        other.head_.next.fill(nullptr);
+        other.size_ = 0;
+        other.max_height_ = 1;
+    }
+
+    ~intrusive_skip_list() {
+        clear();
+    }
+
+    // Итераторы
+    iterator begin() noexcept {
+        return iterator(head_.next[0]);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(head_.next[0]);
+    }
+
+    iterator end() noexcept {
+        return iterator();
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // Модификаторы
+
+    /**
+     * @brief Связывает object со списком
+     * @return Итератор на object либо на уже связанный объект с равным ключом
+     * @throws std::runtime_error если башня object уже связана
+     */
+    std::pair<iterator, bool> insert(T& object) {
+        hook_type& hook = object.*Hook;
+        if (hook.is_linked()) {
+            throw std::runtime_error("Hook is already linked");
+        }
+
+        std::array<hook_type*, LEVELS> update;
+        hook_type* candidate = predecessors(object, update);
+        if (candidate && !comp_(object, *candidate->owner)) {
+            return {iterator(candidate), false};
+        }
+
+        size_t height = random_height();
+        for (size_t i = max_height_; i < height; ++i) {
+            update[i] = &head_;
+        }
+        max_height_ = std::max(max_height_, height);
+
+        hook.owner = &object;
+        hook.height = height;
+        for (size_t i = 0; i < height; ++i) {
+            hook.next[i] = update[i]->next[i];
+            update[i]->next[i] = &hook;
+        }
+        ++size_;
+        return {iterator(&hook), true};
+    }
+
+    /// Отвязывает объект с ключом, равным key
+    size_type erase(const T& key) {
+        std::array<hook_type*, LEVELS> update;
+        hook_type* target = predecessors(key, update);
+        if (!target || comp_(key, *target->owner)) {
+            return 0;
+        }
+        unlink_hook(target, update);
+        return 1;
+    }
+
+    iterator erase(iterator pos) {
+        if (pos == end()) {
+            throw std::out_of_range("Erasing end iterator");
+        }
+        iterator next = std::next(pos);
+        erase(*pos);
+        return next;
+    }
+
+    /**
+     * @brief Отвязывает именно object
+     * @throws std::out_of_range если object не связан с этим списком
+     */
+    void unlink(T& object) {
+        std::array<hook_type*, LEVELS> update;
+        hook_type* target = predecessors(object, update);
+        if (target != &(object.*Hook)) {
+            throw std::out_of_range("Object is not linked into this list");
+        }
+        unlink_hook(target, update);
+    }
+
+    /// Отвязывает все объекты за O(n)
+    void clear() noexcept {
+        hook_type* current = head_.next[0];
+        while (current) {
+            hook_type* next = current->next[0];
+            reset_hook(*current);
+            current = next;
+        }
+        head_.next.fill(nullptr);
+        size_ = 0;
+        max_height_ = 1;
+    }
+
+    // Поиск
+    iterator find(const T& key) {
+        return iterator(find_hook(key));
+    }
+
+    const_iterator find(const T& key) const {
+        return const_iterator(find_hook(key));
+    }
+
+    bool contains(const T& key) const {
+        return find_hook(key) != nullptr;
+    }
+
+    size_type count(const T& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    iterator lower_bound(const T& key) {
+        return iterator(lower_bound_hook(key));
+    }
+
+    const_iterator lower_bound(const T& key) const {
+        return const_iterator(lower_bound_hook(key));
+    }
+
+    // Наблюдатели
+    value_compare value_comp() const {
+        return comp_;
+    }
+
+private:
+    size_t random_height() {
+        size_t height = 1;
+        while (dist_(gen_) < P && height < LEVELS) {
+            ++height;
+        }
+        return height;
+    }
+
+    // Заполняет update предшественниками key и возвращает первую башню
+    // с ключом не меньше key
+    hook_type* predecessors(const T& key, std::array<hook_type*, LEVELS>& update) {
+        hook_type* current = &head_;
+        for (size_t i = max_height_; i-- > 0;) {
+            while (current->next[i] && comp_(*current->next[i]->owner, key)) {
+                current = current->next[i];
+            }
+            update[i] = current;
+        }
+        return current->next[0];
+    }
+
+    hook_type* lower_bound_hook(const T& key) const {
+        const hook_type* current = &head_;
+        for (size_t i = max_height_; i-- > 0;) {
+            while (current->next[i] && comp_(*current->next[i]->owner, key)) {
+                current = current->next[i];
+            }
+        }
+        return current->next[0];
+    }
+
+    hook_type* find_hook(const T& key) const {
+        hook_type* candidate = lower_bound_hook(key);
+        return candidate && !comp_(key, *candidate->owner) ? candidate : nullptr;
+    }
+
+    void unlink_hook(hook_type* target, std::array<hook_type*, LEVELS>& update) noexcept {
+        for (size_t i = 0; i < target->height; ++i) {
+            update[i]->next[i] = target->next[i];
+        }
+        reset_hook(*target);
+        while (max_height_ > 1 && !head_.next[max_height_ - 1]) {
+            --max_height_;
+        }
+        --size_;
+    }
+
+    static void reset_hook(hook_type& hook) noexcept {
+        hook.next.fill(nullptr);
+        hook.owner = nullptr;
+        hook.height = 0;
+    }
+};
+
+} // namespace stl
+
+#endif // INTRUSIVE_SKIP_LIST_HPP
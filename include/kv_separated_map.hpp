@@ -0,0 +1,220 @@
+/**
+ * @file kv_separated_map.hpp
+ * @brief Отображение с ключами в списке с пропусками и значениями в журнале
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef KV_SEPARATED_MAP_HPP
+#define KV_SEPARATED_MAP_HPP
+
+#include "skip_list.hpp"
+#include "value_log.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+namespace detail {
+
+template<typename Key>
+struct kv_entry {
+    Key key;
+    value_locator locator;
+};
+
+template<typename Compare>
+struct kv_entry_less {
+    Compare comp;
+
+    template<typename Key>
+    bool operator()(const kv_entry<Key>& a, const kv_entry<Key>& b) const {
+        return comp(a.key, b.key);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Упорядоченное отображение Key -> байты с разделением ключей и значений
+ *
+ * Список с пропусками хранит только ключ и value_locator, а значения
+ * дописываются в value_log и читаются с диска при обращении. Индекс
+ * остается компактным и горячим, даже когда значения не помещаются в
+ * память.
+ *
+ * Перезапись и удаление освобождают старое значение в журнале. Когда доля
+ * мертвых байт превышает gc_ratio (и их не меньше gc_min_bytes), живые
+ * значения переписываются в новый журнал в порядке ключей. Ошибка такой
+ * автоматической сборки не меняет результат вставки или удаления: старый
+ * журнал остается рабочим, сбой учитывается в gc_failures(), а следующая
+ * попытка откладывается, пока мертвых байт не прибавится еще gc_min_bytes.
+ */
+template<typename Key, typename Compare = std::less<Key>>
+class kv_separated_map {
+    static_assert(std::is_default_constructible_v<Key>,
+                  "Key must be default constructible for the index");
+
+    using entry = detail::kv_entry<Key>;
+    using index_type = skip_list<entry, detail::kv_entry_less<Compare>>;
+
+public:
+    using key_type = Key;
+    using size_type = std::size_t;
+
+    explicit kv_separated_map(std::string log_path, double gc_ratio = 0.5,
+                              uint64_t gc_min_bytes = 1 << 20)
+        : log_(std::move(log_path)), gc_ratio_(gc_ratio), gc_min_bytes_(gc_min_bytes) {}
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return index_.empty();
+    }
+
+    size_type size() const noexcept {
+        return index_.size();
+    }
+
+    // Модификаторы
+
+    /// @return true, если ключ добавлен, false - если значение перезаписано
+    bool insert_or_assign(const Key& key, std::string_view value) {
+        value_locator locator = log_.append(value);
+        auto it = index_.end();
+        try {
+            it = index_.find(probe(key));
+            if (it == index_.end()) {
+                index_.insert(entry{key, locator});
+                return true;
+            }
+        } catch (...) {
+            // Дописанное значение не попало в индекс и сразу мертво
+            log_.release(locator);
+            throw;
+        }
+        log_.release(it->locator);
+        it->locator = locator;
+        maybe_collect();
+        return false;
+    }
+
+    size_type erase(const Key& key) {
+        auto it = index_.find(probe(key));
+        if (it == index_.end()) {
+            return 0;
+        }
+        log_.release(it->locator);
+        index_.erase(it);
+        maybe_collect();
+        return 1;
+    }
+
+    // Поиск
+    std::optional<std::string> get(const Key& key) const {
+        auto it = index_.find(probe(key));
+        if (it == index_.end()) {
+            return std::nullopt;
+        }
+        return log_.read(it->locator);
+    }
+
+    bool contains(const Key& key) const {
+        return index_.count(probe(key)) != 0;
+    }
+
+    /// Вызывает f(key, value) для всех элементов в порядке ключей
+    template<typename F>
+    void for_each(F&& f) const {
+        for (const auto& e : index_) {
+            f(e.key, log_.read(e.locator));
+        }
+    }
+
+    // Журнал
+
+    /**
+     * @brief Переписывает живые значения в новый журнал и заменяет им старый
+     * @throws std::runtime_error при ошибке ввода-вывода; старый журнал и
+     *         индекс остаются прежними, временный файл удаляется
+     */
+    void collect_garbage() {
+        std::string fresh_path = log_.path() + ".gc";
+        value_log fresh(fresh_path);
+        std::vector<value_locator> moved;
+        moved.reserve(index_.size());
+        try {
+            for (const auto& e : std::as_const(index_)) {
+                moved.push_back(fresh.append(log_.read(e.locator)));
+            }
+            log_.replace_with(std::move(fresh));
+        } catch (...) {
+            std::error_code ignored;
+            std::filesystem::remove(fresh_path, ignored);
+            throw;
+        }
+
+        // Индекс меняется только после успешной замены журнала
+        auto next = moved.begin();
+        for (auto& e : index_) {
+            e.locator = *next++;
+        }
+    }
+
+    uint64_t log_bytes() const noexcept {
+        return log_.size_bytes();
+    }
+
+    uint64_t dead_bytes() const noexcept {
+        return log_.dead_bytes();
+    }
+
+    /// Неудачных автоматических сборок мусора
+    size_type gc_failures() const noexcept {
+        return gc_failures_;
+    }
+
+    void sync() {
+        log_.sync();
+    }
+
+private:
+    static entry probe(const Key& key) {
+        return entry{key, value_locator{}};
+    }
+
+    // Вызывается после изменения индекса, поэтому ошибки не выпускает
+    void maybe_collect() noexcept {
+        uint64_t dead = log_.dead_bytes();
+        if (dead >= gc_min_bytes_ && dead >= gc_retry_at_ &&
+            static_cast<double>(dead) > gc_ratio_ * static_cast<double>(log_.size_bytes())) {
+            try {
+                collect_garbage();
+                gc_retry_at_ = 0;
+            } catch (...) {
+                ++gc_failures_;
+                gc_retry_at_ = dead + std::max<uint64_t>(gc_min_bytes_, 1);
+            }
+        }
+    }
+
+    index_type index_;
+    value_log log_;
+    double gc_ratio_;
+    uint64_t gc_min_bytes_;
+    uint64_t gc_retry_at_ = 0;         ///< мертвых байт до повтора после сбоя
+    size_type gc_failures_ = 0;
+};
+
+} // namespace stl
+
+#endif // KV_SEPARATED_MAP_HPP
@@ -0,0 +1,260 @@
+/**
+ * @file left_right_skip_list.hpp
+ * @brief Обертка Left-Right над skip_list с wait-free читателями
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef LEFT_RIGHT_SKIP_LIST_HPP
+#define LEFT_RIGHT_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+#include "concurrency_stats.hpp"
+#include "write_batch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace stl {
+
+namespace detail {
+
+/**
+ * @brief Счетчик читателей, распределенный по кэш-линиям
+ *
+ * Каждый поток увеличивает свою полосу, поэтому читатели не конкурируют
+ * за одну кэш-линию; писатель суммирует все полосы.
+ */
+class read_indicator {
+    static constexpr size_t STRIPES = 16;
+
+    struct alignas(64) stripe {
+        std::atomic<int64_t> value{0};
+    };
+
+public:
+    size_t arrive() noexcept {
+        size_t index = stripe_index();
+        stripes_[index].value.fetch_add(1, std::memory_order_seq_cst);
+        return index;
+    }
+
+    void depart(size_t index) noexcept {
+        stripes_[index].value.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool is_empty() const noexcept {
+        for (const auto& s : stripes_) {
+            if (s.value.load(std::memory_order_seq_cst) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // Полоса назначается потоку один раз по кругу, без реестра потоков
+    static size_t stripe_index() noexcept {
+        static std::atomic<size_t> next{0};
+        thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+        return index;
+    }
+
+    stripe stripes_[STRIPES];
+};
+
+} // namespace detail
+
+/**
+ * @brief Список с пропусками с wait-free чтением по алгоритму Left-Right
+ *
+ * Хранит два экземпляра skip_list. Читатели работают с активным экземпляром,
+ * отмечаясь в индикаторе текущей версии, и никогда не ждут. Писатель
+ * (под мьютексом) применяет изменение к неактивной копии, переключает
+ * читателей на нее, дожидается ухода читателей со старой копии и повторяет
+ * изменение на ней. Память удваивается, поэтому обертка рассчитана на
+ * небольшие списки с редкими изменениями.
+ *
+ * stats() показывает время ожидания мьютекса писателями и время ожидания
+ * ухода читателей со старой копии.
+ */
+template<typename T,
+         typename Compare = std::less<T>,
+         typename Allocator = std::allocator<T>>
+class left_right_skip_list {
+public:
+    using list_type = skip_list<T, Compare, Allocator>;
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+
+private:
+    list_type instances_[2];
+    std::atomic<int> left_right_{0};
+    std::atomic<int> version_index_{0};
+    mutable detail::read_indicator indicators_[2];
+    std::mutex writer_mutex_;
+    concurrency_stats stats_;
+
+public:
+    left_right_skip_list() = default;
+
+    left_right_skip_list(std::initializer_list<value_type> init)
+        : instances_{list_type(init), list_type(init)} {}
+
+    left_right_skip_list(const left_right_skip_list&) = delete;
+    left_right_skip_list& operator=(const left_right_skip_list&) = delete;
+
+    /**
+     * @brief Выполняет f(const list_type&) над активной копией
+     *
+     * Итераторы и ссылки, полученные внутри f, нельзя использовать после
+     * возврата: копия может быть изменена писателем. count() и поиск
+     * const-копии спускаются по сырым указателям, не изменяя счетчики
+     * ссылок узлов, поэтому читатели разных потоков не делят кэш-линии.
+     */
+    template<typename F>
+    decltype(auto) read(F&& f) const {
+        int version = version_index_.load(std::memory_order_seq_cst);
+        size_t stripe = indicators_[version].arrive();
+
+        struct departure {
+            detail::read_indicator& indicator;
+            size_t stripe;
+            ~departure() { indicator.depart(stripe); }
+        } leave{indicators_[version], stripe};
+
+        const list_type& active = instances_[left_right_.load(std::memory_order_seq_cst)];
+        return std::invoke(std::forward<F>(f), active);
+    }
+
+    // Чтение (любой поток, wait-free)
+    bool contains(const value_type& key) const {
+        return read([&key](const list_type& list) { return list.count(key) != 0; });
+    }
+
+    size_type count(const value_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    size_type size() const {
+        return read([](const list_type& list) { return list.size(); });
+    }
+
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+
+    // Модификаторы (сериализуются мьютексом писателя)
+    bool insert(const value_type& value) {
+        return modify([&value](list_type& list) { return list.insert(value).second; });
+    }
+
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    size_type erase(const value_type& key) {
+        return modify([&key](list_type& list) { return list.erase(key); });
+    }
+
+    void clear() {
+        modify([](list_type& list) { list.clear(); });
+    }
+
+    /**
+     * @brief Атомарно применяет пакет вставок и удалений
+     *
+     * Весь пакет вносится в неактивную копию до переключения читателей,
+     * поэтому читатели видят либо все изменения, либо ни одного.
+     *
+     * @return Число фактически вставленных и удаленных элементов
+     */
+    size_type apply_batch(write_batch<value_type>&& batch) {
+        const auto& operations = batch.normalize(Compare());
+        return modify([&operations](list_type& list) {
+            size_type changed = 0;
+            for (const auto& operation : operations) {
+                if (operation.op == write_batch<value_type>::op_type::insert) {
+                    changed += list.insert(operation.value).second ? 1 : 0;
+                } else {
+                    changed += list.erase(operation.value);
+                }
+            }
+            return changed;
+        });
+    }
+
+    /**
+     * @brief Применяет изменение f(list_type&) к обеим копиям
+     *
+     * f вызывается дважды и должна давать одинаковый результат на обеих
+     * копиях; возвращается результат первого вызова.
+     */
+    template<typename F>
+    decltype(auto) modify(F&& f) {
+        std::unique_lock<std::mutex> lock(writer_mutex_, std::try_to_lock);
+        if (lock.owns_lock()) {
+            stats_.lock_wait(std::chrono::nanoseconds(0));
+        } else {
+            auto start = std::chrono::steady_clock::now();
+            lock.lock();
+            stats_.lock_wait(std::chrono::steady_clock::now() - start);
+        }
+        int active = left_right_.load(std::memory_order_relaxed);
+
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, list_type&>>) {
+            std::invoke(f, instances_[1 - active]);
+            publish(1 - active);
+            std::invoke(f, instances_[active]);
+        } else {
+            auto result = std::invoke(f, instances_[1 - active]);
+            publish(1 - active);
+            std::invoke(f, instances_[active]);
+            return result;
+        }
+    }
+
+    /// Счетчики ожиданий писателей; читаются без остановки списка
+    concurrency_stats::snapshot stats() const {
+        return stats_.read();
+    }
+
+private:
+    void publish(int next) {
+        left_right_.store(next, std::memory_order_seq_cst);
+
+        int previous = version_index_.load(std::memory_order_relaxed);
+        int following = 1 - previous;
+
+        wait_until_empty(indicators_[following]);
+        version_index_.store(following, std::memory_order_seq_cst);
+        wait_until_empty(indicators_[previous]);
+    }
+
+    void wait_until_empty(const detail::read_indicator& indicator) {
+        if (indicator.is_empty()) {
+            stats_.drain_wait(std::chrono::nanoseconds(0));
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        while (!indicator.is_empty()) {
+            std::this_thread::yield();
+        }
+        stats_.drain_wait(std::chrono::steady_clock::now() - start);
+    }
+};
+
+} // namespace stl
+
+#endif // LEFT_RIGHT_SKIP_LIST_HPP
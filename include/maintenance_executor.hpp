@@ -0,0 +1,226 @@
+/**
+ * @file maintenance_executor.hpp
+ * @brief Планировщик отложенного обслуживания контейнеров квантами времени
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef MAINTENANCE_EXECUTOR_HPP
+#define MAINTENANCE_EXECUTOR_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace stl {
+
+/**
+ * @brief Выполняет отложенную работу ограниченными квантами
+ *
+ * Задача - функция bool(deadline): она делает часть работы до deadline и
+ * возвращает true, если работа осталась. Незавершенная задача ставится
+ * в конец очереди, поэтому задачи чередуются.
+ *
+ * С ненулевой паузой работает фоновый поток: он выполняет по одному кванту
+ * и засыпает на паузу, не занимая ядро целиком. С нулевой паузой поток не
+ * запускается, и кванты выполняются вызовами run_for() в моменты простоя.
+ *
+ * Задачи, изменяющие однопоточный контейнер, должны брать тот же мьютекс,
+ * что и его владелец (см. locked()), - на время одного кванта. Как
+ * task_executor исполнитель принимает освобождение узлов skip_list
+ * (см. skip_list::set_release_executor).
+ */
+class maintenance_executor : public task_executor {
+public:
+    explicit maintenance_executor(std::chrono::microseconds pause = std::chrono::milliseconds(1),
+                                  std::chrono::microseconds slice = std::chrono::microseconds(200))
+        : pause_(pause), slice_(slice) {
+        if (pause_.count() > 0) {
+            worker_ = std::thread([this] { worker_loop(); });
+        }
+    }
+
+    maintenance_executor(const maintenance_executor&) = delete;
+    maintenance_executor& operator=(const maintenance_executor&) = delete;
+
+    /// Останавливает фоновый поток и доделывает оставшиеся задачи
+    ~maintenance_executor() {
+        if (worker_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            worker_.join();
+        }
+        while (run_for(std::chrono::seconds(1))) {
+        }
+    }
+
+    void post(task t) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(t));
+        }
+        cv_.notify_all();
+    }
+
+    /// Число задач в очереди и выполняющихся
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size() + running_;
+    }
+
+    /**
+     * @brief Выполняет кванты в текущем потоке в пределах budget
+     * @return true, если работа осталась
+     */
+    bool run_for(std::chrono::microseconds budget) {
+        auto stop = clock::now() + budget;
+        while (clock::now() < stop) {
+            if (!run_slice(std::min(stop, clock::now() + slice_))) {
+                break;
+            }
+        }
+        return pending() != 0;
+    }
+
+    /// Ждет, пока очередь опустеет; без фонового потока выполняет ее сам
+    void wait_idle() {
+        if (!worker_.joinable()) {
+            while (run_for(std::chrono::seconds(1))) {
+            }
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return tasks_.empty() && running_ == 0; });
+    }
+
+    std::chrono::microseconds slice() const noexcept {
+        return slice_;
+    }
+
+private:
+    // Выполняет один квант первой задачи; false, если очередь пуста
+    bool run_slice(clock::time_point deadline) {
+        task current;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (tasks_.empty()) {
+                return false;
+            }
+            current = std::move(tasks_.front());
+            tasks_.pop_front();
+            ++running_;
+        }
+
+        bool more = current(deadline);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (more) {
+                tasks_.push_back(std::move(current));
+            }
+            --running_;
+            if (tasks_.empty() && running_ == 0) {
+                idle_cv_.notify_all();
+            }
+        }
+        // Захваченные задачей ресурсы освобождаются вне мьютекса
+        current = nullptr;
+        return true;
+    }
+
+    void worker_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (stopping_) {
+                break;
+            }
+            lock.unlock();
+            run_slice(clock::now() + slice_);
+            lock.lock();
+            cv_.wait_for(lock, pause_, [this] { return stopping_; });
+        }
+    }
+
+    std::chrono::microseconds pause_;
+    std::chrono::microseconds slice_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    std::deque<task> tasks_;
+    size_t running_ = 0;
+    bool stopping_ = false;
+    std::thread worker_;
+};
+
+/// Оборачивает задачу так, что каждый ее квант выполняется под mutex
+template<typename Mutex>
+maintenance_executor::task locked(Mutex& mutex, maintenance_executor::task t) {
+    return [&mutex, t = std::move(t)](maintenance_executor::clock::time_point deadline) {
+        std::lock_guard<Mutex> lock(mutex);
+        return t(deadline);
+    };
+}
+
+namespace detail {
+
+// Повторяет шаг step(batch) до завершения или до deadline
+template<typename Step>
+maintenance_executor::task sliced(Step step) {
+    return [step = std::move(step)](maintenance_executor::clock::time_point deadline) mutable {
+        do {
+            if (!step()) {
+                return false;
+            }
+        } while (maintenance_executor::clock::now() < deadline);
+        return true;
+    };
+}
+
+} // namespace detail
+
+/// Задача освобождения узлов, отложенных списком (set_deferred_release)
+template<typename List>
+maintenance_executor::task release_retired_task(List& list, size_t batch = 256) {
+    return detail::sliced([&list, batch] {
+        list.release_retired(batch);
+        return list.has_retired();
+    });
+}
+
+/// Задача перестройки башен list в порядке ключей
+template<typename List>
+maintenance_executor::task rebuild_towers_task(List& list, size_t batch = 64) {
+    auto cursor = std::make_shared<typename List::maintenance_cursor>();
+    return detail::sliced([&list, cursor, batch] {
+        list.rebuild_towers(*cursor, batch);
+        return !cursor->done;
+    });
+}
+
+/// Задача переразмещения узлов list в порядке ключей
+template<typename List>
+maintenance_executor::task compact_task(List& list, size_t batch = 64) {
+    auto cursor = std::make_shared<typename List::maintenance_cursor>();
+    return detail::sliced([&list, cursor, batch] {
+        list.compact(*cursor, batch);
+        return !cursor->done;
+    });
+}
+
+} // namespace stl
+
+#endif // MAINTENANCE_EXECUTOR_HPP
@@ -0,0 +1,67 @@
+/**
+ * @file node_version.hpp
+ * @brief Счетчик версий узла для оптимистичного чтения конкурентных списков
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef NODE_VERSION_HPP
+#define NODE_VERSION_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace stl {
+
+namespace detail {
+
+/**
+ * @brief Версия участка списка между узлом и его преемником на уровне 0
+ *
+ * Два 32-битных счетчика: начатые и завершенные изменения. Каждый
+ * переполняется сам по себе, без переноса в соседний, поэтому сравнение
+ * на равенство остается верным после 2^32 изменений.
+ * Версия стабильна, когда счетчики равны, что позволяет нескольким писателям
+ * менять один участок одновременно. Писатель окружает изменение ссылки
+ * или состояния узла вызовами begin_write()/end_write(); отсоединенный узел
+ * остается с незавершенным изменением навсегда, и читатель, встретивший его,
+ * начинает заново.
+ */
+class node_version {
+public:
+    void begin_write() noexcept {
+        begun_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void end_write() noexcept {
+        completed_.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Читает версию; false, если участок сейчас изменяется
+    bool read_stable(uint64_t& version) const noexcept {
+        // Завершенные читаются первыми: увидев завершение, читатель видит и
+        // его начало, так что равенство означает отсутствие писателей
+        uint32_t completed = completed_.load(std::memory_order_acquire);
+        uint32_t begun = begun_.load(std::memory_order_acquire);
+        version = begun;
+        return begun == completed;
+    }
+
+    /// Проверяет, что после read_stable() участок не менялся
+    bool validate(uint64_t version) const noexcept {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return begun_.load(std::memory_order_acquire) == version;
+    }
+
+private:
+    std::atomic<uint32_t> begun_{0};
+    std::atomic<uint32_t> completed_{0};
+};
+
+} // namespace detail
+
+} // namespace stl
+
+#endif // NODE_VERSION_HPP
@@ -0,0 +1,669 @@
+/**
+ * @file nohotspot_skip_list.hpp
+ * @brief Неблокирующий список с пропусками без горячих точек с фоновым обслуживанием башен
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef NOHOTSPOT_SKIP_LIST_HPP
+#define NOHOTSPOT_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+#include "concurrency_stats.hpp"
+#include "epoch_reclaimer.hpp"
+#include "node_version.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+/**
+ * @brief Конкурентный список с пропусками по схеме "no hot spot"
+ *
+ * insert и erase работают только с уровнем 0 через CAS: вставка связывает
+ * новый узел с предшественником, удаление лишь помечает узел логически
+ * удаленным. Индексные уровни целиком принадлежат фоновому потоку: он
+ * убирает из индекса и физически отсоединяет удаленные узлы, поднимает
+ * башни новых узлов и добавляет или снимает верхние уровни. Поэтому
+ * пишущие потоки не конкурируют за верхние уровни возле головы.
+ *
+ * Если интервал обслуживания равен нулю, фоновый поток не запускается и
+ * обслуживание выполняется вызовами maintain().
+ *
+ * stats() показывает неудачные CAS по высоте башни предшественника,
+ * перезапуски поиска и очередь узлов, ожидающих освобождения.
+ */
+template<typename T, typename Compare = std::less<T>>
+class nohotspot_skip_list {
+    static_assert(std::is_default_constructible_v<Compare>,
+                  "Compare must be default constructible");
+
+    enum state_type : int { LIVE = 0, DELETED = 1, REMOVED = 2 };
+
+    struct node {
+        T value;
+        std::atomic<uintptr_t> next{0};
+        std::atomic<int> state{LIVE};
+        // Число индексных уровней; пишет только обслуживание, писатели
+        // читают его для статистики
+        std::atomic<size_t> height{0};
+        detail::node_version version;
+
+        explicit node(const T& val) : value(val) {}
+        explicit node(T&& val) : value(std::move(val)) {}
+    };
+
+    struct index_node {
+        node* target;
+        std::atomic<index_node*> right{nullptr};
+        index_node* down;
+
+        index_node(node* t = nullptr, index_node* d = nullptr) : target(t), down(d) {}
+    };
+
+    static constexpr uintptr_t MARK = 1;
+
+    static node* unmarked(uintptr_t link) noexcept {
+        return reinterpret_cast<node*>(link & ~MARK);
+    }
+
+    static bool is_marked(uintptr_t link) noexcept {
+        return (link & MARK) != 0;
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        const_iterator(node* n, epoch_reclaimer::guard guard)
+            : current_(n), guard_(std::move(guard)) {
+            skip_dead();
+        }
+
+        reference operator*() const {
+            if (!current_) {
+                throw std::runtime_error("Dereferencing null iterator");
+            }
+            return current_->value;
+        }
+
+        pointer operator->() const {
+            if (!current_) {
+                throw std::runtime_error("Accessing null iterator");
+            }
+            return &(current_->value);
+        }
+
+        const_iterator& operator++() {
+            if (current_) {
+                current_ = unmarked(current_->next.load(std::memory_order_acquire));
+                skip_dead();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return current_ == other.current_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        void skip_dead() {
+            while (current_ && current_->state.load(std::memory_order_acquire) != LIVE) {
+                current_ = unmarked(current_->next.load(std::memory_order_acquire));
+            }
+        }
+
+        node* current_ = nullptr;
+        epoch_reclaimer::guard guard_;
+    };
+
+    using iterator = const_iterator;
+
+private:
+    node* head_;
+    index_node head_index_[MAX_LEVEL];
+    std::atomic<size_type> levels_{0};
+    value_compare comp_;
+    mutable epoch_reclaimer reclaimer_;
+    mutable concurrency_stats stats_;
+
+    std::chrono::microseconds interval_;
+    std::mutex maintainer_mutex_;
+    std::condition_variable maintainer_cv_;
+    bool stopping_ = false;
+    std::thread maintainer_;
+
+public:
+    nohotspot_skip_list() : nohotspot_skip_list(std::chrono::milliseconds(1)) {}
+
+    explicit nohotspot_skip_list(std::chrono::microseconds interval,
+                                 const Compare& comp = Compare())
+        : head_(new node(T{})), comp_(comp), interval_(interval) {
+        for (size_type i = 0; i < MAX_LEVEL; ++i) {
+            head_index_[i].target = head_;
+            head_index_[i].down = i > 0 ? &head_index_[i - 1] : nullptr;
+        }
+        if (interval_.count() > 0) {
+            maintainer_ = std::thread([this] { maintenance_loop(); });
+        }
+    }
+
+    nohotspot_skip_list(const nohotspot_skip_list&) = delete;
+    nohotspot_skip_list& operator=(const nohotspot_skip_list&) = delete;
+
+    ~nohotspot_skip_list() {
+        if (maintainer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(maintainer_mutex_);
+                stopping_ = true;
+            }
+            maintainer_cv_.notify_one();
+            maintainer_.join();
+        }
+
+        for (size_type i = 0; i < MAX_LEVEL; ++i) {
+            index_node* idx = head_index_[i].right.load(std::memory_order_relaxed);
+            while (idx) {
+                index_node* right = idx->right.load(std::memory_order_relaxed);
+                delete idx;
+                idx = right;
+            }
+        }
+
+        node* current = head_;
+        while (current) {
+            node* next = unmarked(current->next.load(std::memory_order_relaxed));
+            delete current;
+            current = next;
+        }
+    }
+
+    // Итераторы
+    const_iterator begin() const {
+        auto guard = reclaimer_.pin();
+        node* first = unmarked(head_->next.load(std::memory_order_acquire));
+        return const_iterator(first, std::move(guard));
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const {
+        return begin() == end();
+    }
+
+    /// Число живых элементов; обходит уровень 0 за O(n)
+    size_type size() const {
+        size_type count = 0;
+        for (auto it = begin(); it != end(); ++it) {
+            ++count;
+        }
+        return count;
+    }
+
+    /// Текущее число индексных уровней над уровнем 0
+    size_type levels() const noexcept {
+        return levels_.load(std::memory_order_acquire);
+    }
+
+    // Модификаторы (любой поток)
+    bool insert(const value_type& value) {
+        return insert_impl(value);
+    }
+
+    bool insert(value_type&& value) {
+        return insert_impl(std::move(value));
+    }
+
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    size_type erase(const value_type& key) {
+        auto guard = reclaimer_.pin();
+
+        while (true) {
+            node* pred = nullptr;
+            node* current = nullptr;
+            if (!locate(key, pred, current)) {
+                stats_.restart();
+                continue;
+            }
+            if (!current || comp_(key, current->value)) {
+                return 0;
+            }
+
+            int expected = LIVE;
+            current->version.begin_write();
+            bool erased = current->state.compare_exchange_strong(expected, DELETED,
+                                                                 std::memory_order_acq_rel);
+            current->version.end_write();
+            return erased ? 1 : 0;
+        }
+    }
+
+    // Поиск (любой поток)
+    bool contains(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        node* current = lower_bound_node(key);
+        return current && !comp_(key, current->value) &&
+               current->state.load(std::memory_order_acquire) == LIVE;
+    }
+
+    size_type count(const value_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    const_iterator find(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        node* current = lower_bound_node(key);
+        if (current && !comp_(key, current->value) &&
+            current->state.load(std::memory_order_acquire) == LIVE) {
+            return const_iterator(current, std::move(guard));
+        }
+        return end();
+    }
+
+    const_iterator lower_bound(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        return const_iterator(lower_bound_node(key), std::move(guard));
+    }
+
+    /**
+     * @brief Согласованная копия живых элементов из [lo, hi] без блокировок
+     *
+     * Читает уровень 0 оптимистично, запоминая версии пройденных узлов, и
+     * повторяет чтение, если за это время изменилась хотя бы одна ссылка
+     * или состояние узла на участке. Писатели при этом не ждут.
+     */
+    std::vector<value_type> scan(const value_type& lo, const value_type& hi) const {
+        std::vector<value_type> result;
+        std::vector<std::pair<const node*, uint64_t>> versions;
+
+        while (!try_scan(lo, hi, result, versions)) {
+            stats_.scan_retry();
+        }
+        return result;
+    }
+
+    // Наблюдатели
+    value_compare value_comp() const {
+        return comp_;
+    }
+
+    /// Счетчики конкуренции; читаются без остановки списка
+    concurrency_stats::snapshot stats() const {
+        auto result = stats_.read();
+        result.reclamation_backlog = reclaimer_.pending();
+        result.epoch = reclaimer_.epoch();
+        return result;
+    }
+
+    /**
+     * @brief Один проход обслуживания
+     *
+     * Снимает удаленные узлы с индекса, физически отсоединяет их от уровня 0,
+     * поднимает башни и корректирует число уровней. Без фонового потока
+     * вызывается владельцем; одновременно может выполняться только один проход.
+     */
+    void maintain() {
+        auto guard = reclaimer_.pin();
+        remove_deleted_from_index();
+        unlink_deleted();
+        raise_towers();
+        trim_levels();
+        guard = epoch_reclaimer::guard();
+        reclaimer_.reclaim();
+    }
+
+private:
+    // Спуск по индексу к узлу уровня 0, с которого начинается поиск ключа
+    node* index_predecessor(const value_type& key) const {
+        size_type levels = levels_.load(std::memory_order_acquire);
+        if (levels == 0) {
+            return head_;
+        }
+
+        const index_node* idx = &head_index_[levels - 1];
+        while (true) {
+            index_node* right = idx->right.load(std::memory_order_acquire);
+            while (right && comp_(right->target->value, key)) {
+                idx = right;
+                right = idx->right.load(std::memory_order_acquire);
+            }
+            if (!idx->down) {
+                return idx->target;
+            }
+            idx = idx->down;
+        }
+    }
+
+    bool try_scan(const value_type& lo, const value_type& hi, std::vector<value_type>& result,
+                  std::vector<std::pair<const node*, uint64_t>>& versions) const {
+        auto guard = reclaimer_.pin();
+        result.clear();
+        versions.clear();
+
+        const node* start = index_predecessor(lo);
+        const node* current = start;
+        while (true) {
+            uint64_t version;
+            if (!current->version.read_stable(version)) {
+                return false;
+            }
+            versions.emplace_back(current, version);
+
+            if (current != start && !comp_(current->value, lo) &&
+                current->state.load(std::memory_order_acquire) == LIVE) {
+                result.push_back(current->value);
+            }
+
+            uintptr_t link = current->next.load(std::memory_order_acquire);
+            const node* next = unmarked(link);
+            if (is_marked(link)) {
+                return false;
+            }
+            if (!next || comp_(hi, next->value)) {
+                break;
+            }
+            current = next;
+        }
+
+        for (const auto& [n, version] : versions) {
+            if (!n->version.validate(version)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    node* lower_bound_node(const value_type& key) const {
+        node* current = index_predecessor(key);
+        node* next = unmarked(current->next.load(std::memory_order_acquire));
+        while (next && comp_(next->value, key)) {
+            next = unmarked(next->next.load(std::memory_order_acquire));
+        }
+        return next;
+    }
+
+    // Находит pred < key <= current на уровне 0; false, если pred отсоединяется
+    bool locate(const value_type& key, node*& pred, node*& current) const {
+        pred = index_predecessor(key);
+        uintptr_t link = pred->next.load(std::memory_order_acquire);
+        if (is_marked(link)) {
+            return false;
+        }
+
+        current = unmarked(link);
+        while (current && comp_(current->value, key)) {
+            pred = current;
+            link = pred->next.load(std::memory_order_acquire);
+            if (is_marked(link)) {
+                return false;
+            }
+            current = unmarked(link);
+        }
+        return true;
+    }
+
+    template<typename U>
+    bool insert_impl(U&& value) {
+        auto guard = reclaimer_.pin();
+        node* fresh = nullptr;
+
+        while (true) {
+            node* pred = nullptr;
+            node* current = nullptr;
+            if (!locate(value, pred, current)) {
+                stats_.restart();
+                continue;
+            }
+
+            if (current && !comp_(value, current->value)) {
+                int state = current->state.load(std::memory_order_acquire);
+                if (state == LIVE) {
+                    delete fresh;
+                    return false;
+                }
+                if (state == DELETED) {
+                    current->version.begin_write();
+                    bool revived = current->state.compare_exchange_strong(
+                        state, LIVE, std::memory_order_acq_rel);
+                    current->version.end_write();
+                    if (revived) {
+                        delete fresh;
+                        return true;
+                    }
+                    stats_.cas_failure(current->height.load(std::memory_order_relaxed));
+                    continue;
+                }
+                // Узел отсоединяется обслуживанием: повторяем после его ухода
+                stats_.restart();
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (!fresh) {
+                fresh = new node(std::forward<U>(value));
+            }
+            fresh->next.store(reinterpret_cast<uintptr_t>(current), std::memory_order_relaxed);
+
+            uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+            pred->version.begin_write();
+            bool linked = pred->next.compare_exchange_strong(
+                expected, reinterpret_cast<uintptr_t>(fresh),
+                std::memory_order_release, std::memory_order_relaxed);
+            pred->version.end_write();
+            if (linked) {
+                return true;
+            }
+            link_cas_failure(pred);
+        }
+    }
+
+    void link_cas_failure(const node* pred) const noexcept {
+        if (pred == head_) {
+            stats_.head_cas_failure();
+        } else {
+            stats_.cas_failure(pred->height.load(std::memory_order_relaxed));
+        }
+    }
+
+    void maintenance_loop() {
+        std::unique_lock<std::mutex> lock(maintainer_mutex_);
+        while (!stopping_) {
+            lock.unlock();
+            maintain();
+            lock.lock();
+            maintainer_cv_.wait_for(lock, interval_, [this] { return stopping_; });
+        }
+    }
+
+    // Сверху вниз снимает с индекса узлы, не являющиеся живыми. Снимается
+    // только верхний элемент башни: на нижние могут ссылаться down-указатели
+    void remove_deleted_from_index() {
+        size_type levels = levels_.load(std::memory_order_relaxed);
+        for (size_type level = levels; level-- > 0;) {
+            index_node* idx = &head_index_[level];
+            index_node* right = idx->right.load(std::memory_order_relaxed);
+            while (right) {
+                if (right->target->height.load(std::memory_order_relaxed) == level + 1 &&
+                    right->target->state.load(std::memory_order_acquire) != LIVE) {
+                    index_node* after = right->right.load(std::memory_order_relaxed);
+                    idx->right.store(after, std::memory_order_release);
+                    right->target->height.store(level, std::memory_order_relaxed);
+                    reclaimer_.retire(right);
+                    right = after;
+                } else {
+                    idx = right;
+                    right = idx->right.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    // Физически отсоединяет удаленные узлы без индексных уровней
+    void unlink_deleted() {
+        node* pred = head_;
+        node* current = unmarked(pred->next.load(std::memory_order_acquire));
+
+        while (current) {
+            int state = DELETED;
+            if (current->height.load(std::memory_order_relaxed) == 0 &&
+                current->state.compare_exchange_strong(state, REMOVED,
+                                                       std::memory_order_acq_rel)) {
+                // Версия отсоединяемого узла не завершается никогда
+                current->version.begin_write();
+                uintptr_t link = current->next.load(std::memory_order_acquire);
+                while (!current->next.compare_exchange_weak(link, link | MARK,
+                                                            std::memory_order_acq_rel)) {
+                }
+                node* succ = unmarked(link);
+
+                uintptr_t expected = reinterpret_cast<uintptr_t>(current);
+                while (true) {
+                    pred->version.begin_write();
+                    bool unlinked = pred->next.compare_exchange_strong(
+                        expected, reinterpret_cast<uintptr_t>(succ),
+                        std::memory_order_release, std::memory_order_acquire);
+                    pred->version.end_write();
+                    if (unlinked) {
+                        break;
+                    }
+                    link_cas_failure(pred);
+                    // Между pred и current вставлен новый узел
+                    pred = unmarked(expected);
+                    expected = reinterpret_cast<uintptr_t>(current);
+                }
+
+                reclaimer_.retire(current);
+                current = succ;
+                continue;
+            }
+
+            pred = current;
+            current = unmarked(current->next.load(std::memory_order_acquire));
+        }
+    }
+
+    // Поднимает живой элемент уровня, если ни он, ни соседи не подняты
+    void raise_towers() {
+        raise_bottom();
+        for (size_type level = 1; level < MAX_LEVEL - 1; ++level) {
+            if (level > levels_.load(std::memory_order_relaxed) || !raise_index(level)) {
+                break;
+            }
+        }
+    }
+
+    void raise_bottom() {
+        index_node* up = &head_index_[0];
+        node* prev = nullptr;
+        node* current = unmarked(head_->next.load(std::memory_order_acquire));
+        bool raised = false;
+
+        while (current) {
+            node* next = unmarked(current->next.load(std::memory_order_acquire));
+
+            if (current->height.load(std::memory_order_relaxed) >= 1) {
+                up = up->right.load(std::memory_order_relaxed);
+            } else if (current->state.load(std::memory_order_acquire) == LIVE &&
+                       (!prev || prev->height.load(std::memory_order_relaxed) == 0) && next &&
+                       next->height.load(std::memory_order_relaxed) == 0) {
+                auto* idx = new index_node(current, nullptr);
+                idx->right.store(up->right.load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+                up->right.store(idx, std::memory_order_release);
+                current->height.store(1, std::memory_order_relaxed);
+                up = idx;
+                raised = true;
+            }
+
+            prev = current;
+            current = next;
+        }
+
+        if (raised && levels_.load(std::memory_order_relaxed) == 0) {
+            levels_.store(1, std::memory_order_release);
+        }
+    }
+
+    // Поднимает элементы индексного уровня level на уровень level + 1
+    bool raise_index(size_type level) {
+        index_node* up = &head_index_[level];
+        index_node* prev = nullptr;
+        index_node* current = head_index_[level - 1].right.load(std::memory_order_relaxed);
+        bool raised = false;
+
+        while (current) {
+            index_node* next = current->right.load(std::memory_order_relaxed);
+
+            if (current->target->height.load(std::memory_order_relaxed) > level) {
+                up = up->right.load(std::memory_order_relaxed);
+            } else if ((!prev || prev->target->height.load(std::memory_order_relaxed) <= level) &&
+                       next && next->target->height.load(std::memory_order_relaxed) <= level) {
+                auto* idx = new index_node(current->target, current);
+                idx->right.store(up->right.load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+                up->right.store(idx, std::memory_order_release);
+                current->target->height.store(level + 1, std::memory_order_relaxed);
+                up = idx;
+                raised = true;
+            }
+
+            prev = current;
+            current = next;
+        }
+
+        if (raised && levels_.load(std::memory_order_relaxed) == level) {
+            levels_.store(level + 1, std::memory_order_release);
+        }
+        return raised || levels_.load(std::memory_order_relaxed) > level + 1;
+    }
+
+    // Снимает опустевшие верхние уровни
+    void trim_levels() {
+        size_type levels = levels_.load(std::memory_order_relaxed);
+        while (levels > 0 && !head_index_[levels - 1].right.load(std::memory_order_relaxed)) {
+            --levels;
+        }
+        levels_.store(levels, std::memory_order_release);
+    }
+};
+
+} // namespace stl
+
+#endif // NOHOTSPOT_SKIP_LIST_HPP
@@ -0,0 +1,616 @@
+/**
+ * @file offset_skip_list.hpp
+ * @brief Список с пропусками в непрерывной куче со ссылками-смещениями
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef OFFSET_SKIP_LIST_HPP
+#define OFFSET_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+namespace detail {
+
+/**
+ * @brief Заголовок кучи offset_skip_list, лежит по смещению 0
+ */
+struct offset_heap_header {
+    static constexpr uint64_t MAGIC = 0x5350'4c49'5354'4f46;  // "FOTSILPS"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t value_size;
+    uint64_t used;                     ///< занятые байты кучи
+    uint64_t size;
+    uint32_t level;
+    uint32_t clean;                    ///< куча согласована с последней контрольной точкой
+    uint64_t head;
+    uint64_t free[MAX_LEVEL];          ///< списки свободных узлов по высоте
+};
+
+} // namespace detail
+
+/**
+ * @brief Упорядоченное множество в одной непрерывной куче
+ *
+ * Узлы и заголовок лежат в памяти, которую предоставляет Storage, а ссылки
+ * хранятся как смещения от ее начала. Поэтому кучу можно перенести
+ * (расширить с mremap, отобразить в другой процесс, скопировать memcpy)
+ * без исправления указателей. Storage - тип с членами
+ *   char* data(), size_t capacity(), void reserve(size_t bytes),
+ *   void flush();
+ * reserve сохраняет содержимое, новые байты заполнены нулями. Если Storage
+ * создается по умолчанию, копия списка - один memcpy занятой части кучи.
+ *
+ * Запись ведется в порядке, безопасном при обрыве процесса в любой точке:
+ * новый узел полностью заполняется до публикации и связывается сначала
+ * на уровне 0, затем выше; удаление снимает узел сверху вниз. Уровень 0
+ * всегда остается корректным списком. Размер и свободные узлы могут
+ * отстать от связей; первая мутация после checkpoint() снимает флаг
+ * clean, и открытие кучи без него пересчитывает их обходом (recovered()).
+ *
+ * Этот порядок защищает только от обрыва процесса, но не от потери
+ * питания: страницы отображения сбрасываются на диск в произвольном
+ * порядке, и связь может попасть на диск раньше узла. Согласованной на
+ * диске гарантированно остается куча последней checkpoint(). Открытие
+ * проверяет заголовок и все связи и отвергает поврежденную кучу.
+ *
+ * T должен быть тривиально копируемым: значения хранятся в куче побайтно.
+ * Итераторы действительны до следующей вставки, которая может перенести
+ * кучу. Итератор хранит указатель на свой список, поэтому перемещение
+ * списка тоже делает его итераторы недействительными.
+ */
+template<typename T, typename Compare, typename Storage>
+class offset_skip_list {
+    template<typename, typename, typename>
+    friend class offset_skip_list;
+
+    static_assert(std::is_trivially_copyable_v<T>, "offset_skip_list requires trivially copyable T");
+
+    using header = detail::offset_heap_header;
+
+    struct node {
+        uint64_t height;
+        T value;
+    };
+
+    static constexpr size_t LINKS_OFFSET = (sizeof(node) + 7) & ~size_t{7};
+    static constexpr size_t NODE_ALIGN = std::max(alignof(node), alignof(uint64_t));
+    static constexpr size_t INITIAL_BYTES = 64 * 1024;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_compare = Compare;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        const_iterator(const offset_skip_list* owner, uint64_t offset)
+            : owner_(owner), offset_(offset) {}
+
+        reference operator*() const {
+            if (!offset_) {
+                throw std::runtime_error("Dereferencing null iterator");
+            }
+            return owner_->node_at(offset_)->value;
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (offset_) {
+                offset_ = owner_->links(offset_)[0];
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return offset_ == other.offset_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const offset_skip_list* owner_ = nullptr;
+        uint64_t offset_ = 0;
+    };
+
+    using iterator = const_iterator;
+
+    /**
+     * @brief Открывает кучу в storage или размечает пустую
+     *
+     * Существующая куча проверяется одним обходом всех узлов и связей,
+     * O(n log n); узлы не перестраиваются.
+     *
+     * @throws std::runtime_error если storage содержит чужие данные или
+     *         связи кучи повреждены
+     */
+    explicit offset_skip_list(Storage storage, const Compare& comp = Compare())
+        : storage_(std::move(storage)), comp_(comp), gen_(std::random_device{}()), dist_(0.0, 1.0) {
+        if (storage_.capacity() < sizeof(header) || hdr().magic == 0) {
+            format();
+        } else if (hdr().magic != header::MAGIC || hdr().version != header::VERSION ||
+                   hdr().value_size != sizeof(T) || hdr().used > storage_.capacity()) {
+            throw std::runtime_error("Storage does not hold a compatible skip list heap");
+        } else {
+            std::vector<uint64_t> live = validate();
+            if (!hdr().clean) {
+                recover(live);
+                recovered_ = true;
+            }
+        }
+    }
+
+    /// Копирует кучу other одним memcpy
+    offset_skip_list(const offset_skip_list& other)
+        requires std::default_initializable<Storage>
+        : comp_(other.comp_), gen_(std::random_device{}()), dist_(0.0, 1.0) {
+        clone_heap(other.storage_.data(), other.heap_bytes());
+    }
+
+    /// Копирует кучу списка с другим хранилищем, например файлового
+    template<typename OtherStorage>
+    explicit offset_skip_list(const offset_skip_list<T, Compare, OtherStorage>& other)
+        requires std::default_initializable<Storage>
+        : comp_(other.comp_), gen_(std::random_device{}()), dist_(0.0, 1.0) {
+        clone_heap(other.storage_.data(), other.heap_bytes());
+    }
+
+    /// Переиспользует память кучи, если ее хватает
+    offset_skip_list& operator=(const offset_skip_list& other)
+        requires std::default_initializable<Storage>
+    {
+        if (this != &other) {
+            clone_heap(other.storage_.data(), other.heap_bytes());
+            comp_ = other.comp_;
+        }
+        return *this;
+    }
+
+    offset_skip_list(offset_skip_list&&) noexcept = default;
+
+    /// Перед заменой хранилища сохраняет текущую кучу контрольной точкой
+    offset_skip_list& operator=(offset_skip_list&& other) noexcept {
+        if (this != &other) {
+            release_storage();
+            storage_ = std::move(other.storage_);
+            comp_ = std::move(other.comp_);
+            gen_ = std::move(other.gen_);
+            dist_ = std::move(other.dist_);
+            recovered_ = other.recovered_;
+        }
+        return *this;
+    }
+
+    /// Сохраняет кучу контрольной точкой
+    ~offset_skip_list() {
+        release_storage();
+    }
+
+    // Итераторы
+    const_iterator begin() const noexcept {
+        return const_iterator(this, links(hdr().head)[0]);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type size() const noexcept {
+        return static_cast<size_type>(hdr().size);
+    }
+
+    /// Байт кучи, занятых заголовком и узлами
+    size_t heap_bytes() const noexcept {
+        return static_cast<size_t>(hdr().used);
+    }
+
+    /// true, если при открытии куча восстанавливалась после обрыва
+    bool recovered() const noexcept {
+        return recovered_;
+    }
+
+    // Модификаторы
+    std::pair<iterator, bool> insert(const value_type& value) {
+        uint64_t update[MAX_LEVEL];
+        uint64_t candidate = predecessors(value, update);
+        if (candidate && !comp_(value, node_at(candidate)->value)) {
+            return {iterator(this, candidate), false};
+        }
+
+        mark_dirty();
+        size_t height = random_height();
+        for (size_t i = hdr().level; i < height; ++i) {
+            update[i] = hdr().head;
+        }
+        uint64_t fresh = acquire_node(height);
+        node_at(fresh)->value = value;
+        for (size_t i = 0; i < height; ++i) {
+            links(fresh)[i] = links(update[i])[i];
+        }
+        // Узел заполнен; публикуем его снизу вверх
+        for (size_t i = 0; i < height; ++i) {
+            write_barrier();
+            links(update[i])[i] = fresh;
+        }
+        hdr().level = std::max<uint32_t>(hdr().level, static_cast<uint32_t>(height));
+        ++hdr().size;
+        return {iterator(this, fresh), true};
+    }
+
+    size_type erase(const value_type& key) {
+        uint64_t update[MAX_LEVEL];
+        uint64_t target = predecessors(key, update);
+        if (!target || comp_(key, node_at(target)->value)) {
+            return 0;
+        }
+
+        mark_dirty();
+        size_t height = static_cast<size_t>(node_at(target)->height);
+        // Сверху вниз: до последнего шага узел остается на уровне 0. После
+        // оборванной вставки узел может быть связан не на всех уровнях
+        for (size_t i = height; i-- > 0;) {
+            if (links(update[i])[i] == target) {
+                links(update[i])[i] = links(target)[i];
+                write_barrier();
+            }
+        }
+        while (hdr().level > 1 && !links(hdr().head)[hdr().level - 1]) {
+            --hdr().level;
+        }
+        --hdr().size;
+        links(target)[0] = hdr().free[height - 1];
+        hdr().free[height - 1] = target;
+        return 1;
+    }
+
+    /// Размечает кучу заново; память storage не возвращается
+    void clear() {
+        mark_dirty();
+        format();
+    }
+
+    /**
+     * @brief Фиксирует кучу в Storage и отмечает ее согласованной
+     *
+     * Сначала сбрасываются данные, затем флаг clean, так что флаг не
+     * попадает в Storage раньше узлов.
+     */
+    void checkpoint() {
+        storage_.flush();
+        hdr().clean = 1;
+        storage_.flush();
+    }
+
+    // Поиск
+    const_iterator find(const value_type& key) const {
+        uint64_t candidate = lower_bound_offset(key);
+        return candidate && !comp_(key, node_at(candidate)->value) ? const_iterator(this, candidate)
+                                                                    : end();
+    }
+
+    bool contains(const value_type& key) const {
+        return find(key) != end();
+    }
+
+    size_type count(const value_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    const_iterator lower_bound(const value_type& key) const {
+        return const_iterator(this, lower_bound_offset(key));
+    }
+
+    const_iterator upper_bound(const value_type& key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && !comp_(key, *it) ? std::next(it) : it;
+    }
+
+    value_compare value_comp() const {
+        return comp_;
+    }
+
+protected:
+    Storage& storage() noexcept {
+        return storage_;
+    }
+
+    const Storage& storage() const noexcept {
+        return storage_;
+    }
+
+private:
+    // Запрещает компилятору переставлять записи публикации узла
+    static void write_barrier() noexcept {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    header& hdr() noexcept {
+        return *reinterpret_cast<header*>(storage_.data());
+    }
+
+    const header& hdr() const noexcept {
+        return *reinterpret_cast<const header*>(storage_.data());
+    }
+
+    node* node_at(uint64_t offset) noexcept {
+        return reinterpret_cast<node*>(storage_.data() + offset);
+    }
+
+    const node* node_at(uint64_t offset) const noexcept {
+        return reinterpret_cast<const node*>(storage_.data() + offset);
+    }
+
+    uint64_t* links(uint64_t offset) noexcept {
+        return reinterpret_cast<uint64_t*>(storage_.data() + offset + LINKS_OFFSET);
+    }
+
+    const uint64_t* links(uint64_t offset) const noexcept {
+        return reinterpret_cast<const uint64_t*>(storage_.data() + offset + LINKS_OFFSET);
+    }
+
+    static size_t node_bytes(size_t height) noexcept {
+        size_t bytes = LINKS_OFFSET + height * sizeof(uint64_t);
+        return (bytes + NODE_ALIGN - 1) & ~(NODE_ALIGN - 1);
+    }
+
+    static size_t heap_start() noexcept {
+        return (sizeof(header) + NODE_ALIGN - 1) & ~(NODE_ALIGN - 1);
+    }
+
+    void format() {
+        size_t head_end = heap_start() + node_bytes(MAX_LEVEL);
+        if (storage_.capacity() < head_end) {
+            storage_.reserve(std::max(INITIAL_BYTES, head_end));
+        }
+        std::memset(storage_.data(), 0, head_end);
+        header& h = hdr();
+        h.magic = header::MAGIC;
+        h.version = header::VERSION;
+        h.value_size = sizeof(T);
+        h.used = head_end;
+        h.size = 0;
+        h.level = 1;
+        h.clean = 0;
+        h.head = heap_start();
+        node_at(h.head)->height = MAX_LEVEL;
+    }
+
+    void clone_heap(const char* data, size_t used) {
+        if (storage_.capacity() < used) {
+            storage_.reserve(used);
+        }
+        std::memcpy(storage_.data(), data, used);
+    }
+
+    void mark_dirty() {
+        if (hdr().clean) {
+            hdr().clean = 0;
+            storage_.flush();
+        }
+    }
+
+    size_t random_height() {
+        size_t height = 1;
+        while (dist_(gen_) < P && height < MAX_LEVEL) {
+            ++height;
+        }
+        return height;
+    }
+
+    uint64_t acquire_node(size_t height) {
+        uint64_t& free_list = hdr().free[height - 1];
+        if (free_list) {
+            uint64_t offset = free_list;
+            free_list = links(offset)[0];
+            return offset;
+        }
+
+        size_t bytes = node_bytes(height);
+        uint64_t offset = hdr().used;
+        if (offset + bytes > storage_.capacity()) {
+            storage_.reserve(std::max(storage_.capacity() * 2, offset + bytes));
+        }
+        // Высота пишется до сдвига used, чтобы куча оставалась разбираемой
+        node_at(offset)->height = height;
+        write_barrier();
+        hdr().used = offset + bytes;
+        return offset;
+    }
+
+    uint64_t predecessors(const value_type& key, uint64_t* update) const {
+        uint64_t current = hdr().head;
+        for (size_t i = hdr().level; i-- > 0;) {
+            while (links(current)[i] && comp_(node_at(links(current)[i])->value, key)) {
+                current = links(current)[i];
+            }
+            update[i] = current;
+        }
+        return links(current)[0];
+    }
+
+    uint64_t lower_bound_offset(const value_type& key) const {
+        uint64_t current = hdr().head;
+        for (size_t i = hdr().level; i-- > 0;) {
+            while (links(current)[i] && comp_(node_at(links(current)[i])->value, key)) {
+                current = links(current)[i];
+            }
+        }
+        return links(current)[0];
+    }
+
+    [[noreturn]] static void corrupted() {
+        throw std::runtime_error("Corrupted skip list heap");
+    }
+
+    /**
+     * @brief Проверяет заголовок и связи кучи
+     *
+     * Каждая связь должна указывать на начало узла внутри занятой части
+     * кучи; уровень 0 - строго возрастающая цепочка без циклов, связь
+     * уровня i ведет к живому узлу высоты больше i. У согласованной кучи
+     * проверяются также размер и списки свободных узлов.
+     *
+     * @return Смещения живых узлов по возрастанию
+     * @throws std::runtime_error "Corrupted skip list heap"
+     */
+    std::vector<uint64_t> validate() const {
+        const header& h = hdr();
+        uint64_t first = heap_start() + node_bytes(MAX_LEVEL);
+        if (h.head != heap_start() || h.used < first || h.used % NODE_ALIGN != 0 ||
+            h.level == 0 || h.level > MAX_LEVEL || node_at(h.head)->height != MAX_LEVEL) {
+            corrupted();
+        }
+
+        // Узлы лежат подряд, поэтому их начала идут по возрастанию
+        std::vector<uint64_t> starts;
+        for (uint64_t offset = first; offset < h.used;) {
+            uint64_t height = node_at(offset)->height;
+            if (height == 0 || height > MAX_LEVEL || node_bytes(height) > h.used - offset) {
+                corrupted();
+            }
+            starts.push_back(offset);
+            offset += node_bytes(height);
+        }
+        auto is_node = [&starts](uint64_t offset) {
+            return std::binary_search(starts.begin(), starts.end(), offset);
+        };
+
+        std::vector<uint64_t> live;
+        for (uint64_t offset = links(h.head)[0]; offset; offset = links(offset)[0]) {
+            if (!is_node(offset) || live.size() == starts.size() ||
+                (!live.empty() && !comp_(node_at(live.back())->value, node_at(offset)->value))) {
+                corrupted();
+            }
+            live.push_back(offset);
+        }
+        std::sort(live.begin(), live.end());
+        auto is_live = [&live](uint64_t offset) {
+            return std::binary_search(live.begin(), live.end(), offset);
+        };
+
+        auto check_tower = [&](uint64_t offset, size_t height) {
+            for (size_t i = 1; i < height; ++i) {
+                uint64_t next = links(offset)[i];
+                if (next && (!is_live(next) || node_at(next)->height <= i ||
+                             (offset != h.head &&
+                              !comp_(node_at(offset)->value, node_at(next)->value)))) {
+                    corrupted();
+                }
+            }
+        };
+        check_tower(h.head, MAX_LEVEL);
+        for (uint64_t offset : live) {
+            check_tower(offset, static_cast<size_t>(node_at(offset)->height));
+        }
+
+        if (h.clean) {
+            if (h.size != live.size()) {
+                corrupted();
+            }
+            size_t free_nodes = 0;
+            for (size_t k = 0; k < MAX_LEVEL; ++k) {
+                for (uint64_t offset = h.free[k]; offset; offset = links(offset)[0]) {
+                    if (!is_node(offset) || is_live(offset) || node_at(offset)->height != k + 1 ||
+                        ++free_nodes > starts.size()) {
+                        corrupted();
+                    }
+                }
+            }
+        }
+        return live;
+    }
+
+    /**
+     * @brief Пересчитывает размер, уровень и свободные узлы по связям
+     *
+     * Достижимые по уровню 0 узлы живые; остальные узлы кучи, включая
+     * оставшиеся от оборванных вставок и удалений, становятся свободными.
+     * live - результат validate().
+     */
+    void recover(const std::vector<uint64_t>& live) {
+        header& h = hdr();
+        std::fill(std::begin(h.free), std::end(h.free), 0);
+        uint64_t offset = h.head + node_bytes(MAX_LEVEL);
+        while (offset < h.used) {
+            size_t height = static_cast<size_t>(node_at(offset)->height);
+            if (!std::binary_search(live.begin(), live.end(), offset)) {
+                links(offset)[0] = h.free[height - 1];
+                h.free[height - 1] = offset;
+            }
+            offset += node_bytes(height);
+        }
+
+        h.size = live.size();
+        h.level = 1;
+        for (uint32_t i = MAX_LEVEL; i > 1; --i) {
+            if (links(h.head)[i - 1]) {
+                h.level = i;
+                break;
+            }
+        }
+    }
+
+    void release_storage() noexcept {
+        if (storage_.capacity() >= sizeof(header)) {
+            try {
+                checkpoint();
+            } catch (...) {
+                // Флаг clean остается снятым, следующее открытие восстановит кучу
+            }
+        }
+    }
+
+    Storage storage_;
+    value_compare comp_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+    bool recovered_ = false;
+};
+
+} // namespace stl
+
+#endif // OFFSET_SKIP_LIST_HPP
@@ -0,0 +1,182 @@
+/**
+ * @file persistent_skip_list.hpp
+ * @brief Изменяемый список с пропусками в отображенном в память файле
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef PERSISTENT_SKIP_LIST_HPP
+#define PERSISTENT_SKIP_LIST_HPP
+
+#include "offset_skip_list.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stl {
+
+/**
+ * @brief Файл, целиком отображенный в память с MAP_SHARED
+ *
+ * Хранилище для offset_skip_list: reserve расширяет файл через ftruncate
+ * (новые байты - нули) и переотображает его, flush вызывает msync.
+ */
+class mapped_file {
+public:
+    explicit mapped_file(std::string path) : path_(std::move(path)) {
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw_errno("Cannot open mapped file");
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            int saved = errno;
+            ::close(fd_);
+            errno = saved;
+            throw_errno("Cannot stat mapped file");
+        }
+        if (st.st_size > 0) {
+            try {
+                map(static_cast<size_t>(st.st_size));
+            } catch (...) {
+                ::close(fd_);
+                throw;
+            }
+        }
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : path_(std::move(other.path_)), fd_(std::exchange(other.fd_, -1)),
+          data_(std::exchange(other.data_, nullptr)), capacity_(std::exchange(other.capacity_, 0)) {}
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            fd_ = std::exchange(other.fd_, -1);
+            data_ = std::exchange(other.data_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        close();
+    }
+
+    char* data() noexcept {
+        return data_;
+    }
+
+    const char* data() const noexcept {
+        return data_;
+    }
+
+    size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+    void reserve(size_t bytes) {
+        if (bytes <= capacity_) {
+            return;
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            throw_errno("Cannot grow mapped file");
+        }
+        map(bytes);
+    }
+
+    void flush() {
+        if (data_ && ::msync(data_, capacity_, MS_SYNC) != 0) {
+            throw_errno("Cannot sync mapped file");
+        }
+    }
+
+    const std::string& path() const noexcept {
+        return path_;
+    }
+
+private:
+    void map(size_t bytes) {
+        void* mapped = data_ ? ::mremap(data_, capacity_, bytes, MREMAP_MAYMOVE)
+                             : ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapped == MAP_FAILED) {
+            throw_errno("Cannot map file");
+        }
+        data_ = static_cast<char*>(mapped);
+        capacity_ = bytes;
+    }
+
+    void close() noexcept {
+        if (data_) {
+            ::munmap(data_, capacity_);
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    [[noreturn]] void throw_errno(const char* what) const {
+        throw std::runtime_error(std::string(what) + " '" + path_ + "': " + std::strerror(errno));
+    }
+
+    std::string path_;
+    int fd_ = -1;
+    char* data_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+/**
+ * @brief Упорядоченное множество, живущее в файле
+ *
+ * Открытие существующего файла проверяет связи одним обходом, но не
+ * перестраивает узлы: список сразу работает поверх отображения. После
+ * закрытия деструктором или checkpoint() файл согласован; после обрыва
+ * процесса открытие пересчитывает размер и свободные узлы (см.
+ * offset_skip_list). От сбоя питания защищает только checkpoint(): ядро
+ * записывает страницы в произвольном порядке, поэтому изменения после
+ * последней контрольной точки могут оставить на диске несогласованную
+ * кучу, и открытие отвергнет ее с std::runtime_error.
+ *
+ * Файл привязан к T и размеру T, но не к Compare: открывать его нужно с
+ * тем же порядком, с которым он заполнялся.
+ */
+template<typename T, typename Compare = std::less<T>>
+class persistent_skip_list : public offset_skip_list<T, Compare, mapped_file> {
+    using base = offset_skip_list<T, Compare, mapped_file>;
+
+public:
+    /// Открывает файл path или создает пустой список в нем
+    explicit persistent_skip_list(const std::string& path, const Compare& comp = Compare())
+        : base(mapped_file(path), comp) {}
+
+    const std::string& path() const noexcept {
+        return this->storage().path();
+    }
+
+    /// Размер файла
+    size_t file_bytes() const noexcept {
+        return this->storage().capacity();
+    }
+};
+
+} // namespace stl
+
+#endif // PERSISTENT_SKIP_LIST_HPP
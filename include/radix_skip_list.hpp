@@ -0,0 +1,353 @@
+/**
+ * @file radix_skip_list.hpp
+ * @brief Список с пропусками для целых ключей с каталогом по старшим битам
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef RADIX_SKIP_LIST_HPP
+#define RADIX_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+/**
+ * @brief Множество целых ключей: каталог по старшим битам плюс список с пропусками
+ *
+ * Пространство ключей [0, 2^key_bits) делится на 2^dir_bits корзин. Элемент
+ * каталога хранит последний узел уровня не ниже dir_level с ключом меньше
+ * начала корзины, поэтому поиск начинается с уровня dir_level рядом с целью,
+ * а не с вершины головы. Ключи за пределами [0, 2^key_bits) попадают в
+ * крайние корзины; при полной ширине знаковые ключи упорядочиваются
+ * инверсией знакового бита.
+ *
+ * Каталог поддерживается при вставке и удалении узлов с уровнем не ниже
+ * dir_level: меняются только корзины между соседними такими узлами.
+ * Остальные уровни строятся как в skip_list и используются, когда башне
+ * нового узла нужны предшественники выше dir_level.
+ */
+template<std::integral Key>
+class radix_skip_list {
+    using unsigned_key = std::make_unsigned_t<Key>;
+
+    static constexpr unsigned KEY_WIDTH = std::numeric_limits<unsigned_key>::digits;
+
+    struct node {
+        Key key;
+        std::vector<node*> forward;
+
+        node(Key k, size_t level) : key(k), forward(level + 1, nullptr) {}
+
+        size_t level() const noexcept {
+            return forward.size() - 1;
+        }
+    };
+
+public:
+    using value_type = Key;
+    using key_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        const_iterator() = default;
+        explicit const_iterator(const node* n) : current_(n) {}
+
+        reference operator*() const {
+            if (!current_) {
+                throw std::runtime_error("Dereferencing null iterator");
+            }
+            return current_->key;
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (current_) {
+                current_ = current_->forward[0];
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return current_ == other.current_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const node* current_ = nullptr;
+    };
+
+    using iterator = const_iterator;
+
+private:
+    node* head_;
+    size_type size_ = 0;
+    size_type max_level_ = 0;
+    unsigned key_bits_;
+    unsigned dir_bits_;
+    size_type dir_level_;
+    std::vector<node*> directory_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+
+public:
+    /**
+     * @param dir_bits  Число старших битов ключа, индексирующих каталог
+     * @param key_bits  Ширина используемого пространства ключей
+     * @param dir_level Уровень, на который указывают элементы каталога
+     */
+    explicit radix_skip_list(unsigned dir_bits = 16, unsigned key_bits = KEY_WIDTH,
+                             size_type dir_level = 1)
+        : head_(new node(Key{}, MAX_LEVEL - 1)), key_bits_(key_bits), dir_bits_(dir_bits),
+          dir_level_(dir_level), gen_(std::random_device{}()), dist_(0.0, 1.0) {
+        if (key_bits_ == 0 || key_bits_ > KEY_WIDTH || dir_bits_ > key_bits_ || dir_bits_ > 30) {
+            delete head_;
+            throw std::out_of_range("Invalid radix directory geometry");
+        }
+        if (dir_level_ >= MAX_LEVEL) {
+            delete head_;
+            throw std::out_of_range("Directory level exceeds MAX_LEVEL");
+        }
+        directory_.assign(size_type{1} << dir_bits_, head_);
+    }
+
+    radix_skip_list(std::initializer_list<Key> init) : radix_skip_list() {
+        for (Key key : init) {
+            insert(key);
+        }
+    }
+
+    radix_skip_list(const radix_skip_list&) = delete;
+    radix_skip_list& operator=(const radix_skip_list&) = delete;
+
+    ~radix_skip_list() {
+        release_nodes();
+        delete head_;
+    }
+
+    // Итераторы
+    const_iterator begin() const noexcept {
+        return const_iterator(head_->forward[0]);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    // Модификаторы
+    std::pair<iterator, bool> insert(Key key) {
+        std::vector<node*> update(MAX_LEVEL, head_);
+        node* current = directory_predecessors(key, update);
+        if (current && current->key == key) {
+            return {iterator(current), false};
+        }
+
+        size_type level = random_level();
+        if (level > dir_level_) {
+            full_predecessors(key, update, level);
+        }
+        max_level_ = std::max(max_level_, level);
+
+        auto* fresh = new node(key, level);
+        for (size_type i = 0; i <= level; ++i) {
+            fresh->forward[i] = update[i]->forward[i];
+            update[i]->forward[i] = fresh;
+        }
+
+        if (level >= dir_level_) {
+            for (size_type b = bucket(key) + 1;
+                 b < directory_.size() && directory_[b] == update[dir_level_]; ++b) {
+                directory_[b] = fresh;
+            }
+        }
+
+        ++size_;
+        return {iterator(fresh), true};
+    }
+
+    size_type erase(Key key) {
+        std::vector<node*> update(MAX_LEVEL, head_);
+        node* target = directory_predecessors(key, update);
+        if (!target || target->key != key) {
+            return 0;
+        }
+
+        size_type level = target->level();
+        if (level > dir_level_) {
+            full_predecessors(key, update, level);
+        }
+        for (size_type i = 0; i <= level; ++i) {
+            update[i]->forward[i] = target->forward[i];
+        }
+
+        if (level >= dir_level_) {
+            for (size_type b = bucket(key) + 1;
+                 b < directory_.size() && directory_[b] == target; ++b) {
+                directory_[b] = update[dir_level_];
+            }
+        }
+
+        while (max_level_ > 0 && !head_->forward[max_level_]) {
+            --max_level_;
+        }
+        delete target;
+        --size_;
+        return 1;
+    }
+
+    void clear() noexcept {
+        release_nodes();
+        std::fill(head_->forward.begin(), head_->forward.end(), nullptr);
+        std::fill(directory_.begin(), directory_.end(), head_);
+        size_ = 0;
+        max_level_ = 0;
+    }
+
+    // Поиск
+    const_iterator find(Key key) const {
+        const node* current = lower_bound_node(key);
+        return current && current->key == key ? const_iterator(current) : end();
+    }
+
+    bool contains(Key key) const {
+        return find(key) != end();
+    }
+
+    size_type count(Key key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    const_iterator lower_bound(Key key) const {
+        return const_iterator(lower_bound_node(key));
+    }
+
+    const_iterator upper_bound(Key key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && *it == key ? std::next(it) : it;
+    }
+
+    // Наблюдатели
+    unsigned dir_bits() const noexcept {
+        return dir_bits_;
+    }
+
+    unsigned key_bits() const noexcept {
+        return key_bits_;
+    }
+
+    size_type dir_level() const noexcept {
+        return dir_level_;
+    }
+
+private:
+    size_type random_level() {
+        size_type level = 0;
+        while (dist_(gen_) < P && level < MAX_LEVEL - 1) {
+            ++level;
+        }
+        return level;
+    }
+
+    // Номер корзины не убывает вместе с ключом
+    size_type bucket(Key key) const noexcept {
+        unsigned_key bits = static_cast<unsigned_key>(key);
+        if (key_bits_ == KEY_WIDTH) {
+            if constexpr (std::is_signed_v<Key>) {
+                bits ^= unsigned_key{1} << (KEY_WIDTH - 1);
+            }
+        } else if (key < Key{0}) {
+            return 0;
+        } else if ((bits >> key_bits_) != 0) {
+            return directory_.size() - 1;
+        }
+        return dir_bits_ == 0 ? 0 : static_cast<size_type>(bits >> (key_bits_ - dir_bits_));
+    }
+
+    // Спуск от элемента каталога: заполняет update на уровнях 0..dir_level
+    // и возвращает первый узел с ключом не меньше key
+    node* directory_predecessors(Key key, std::vector<node*>& update) const {
+        node* current = directory_[bucket(key)];
+        for (size_type i = dir_level_ + 1; i-- > 0;) {
+            while (current->forward[i] && current->forward[i]->key < key) {
+                current = current->forward[i];
+            }
+            update[i] = current;
+        }
+        return current->forward[0];
+    }
+
+    // Обычный спуск от головы для уровней выше dir_level
+    void full_predecessors(Key key, std::vector<node*>& update, size_type top) const {
+        node* current = head_;
+        for (size_type i = std::max(max_level_, top) + 1; i-- > dir_level_ + 1;) {
+            while (current->forward[i] && current->forward[i]->key < key) {
+                current = current->forward[i];
+            }
+            update[i] = current;
+        }
+    }
+
+    const node* lower_bound_node(Key key) const {
+        const node* current = directory_[bucket(key)];
+        for (size_type i = dir_level_ + 1; i-- > 0;) {
+            while (current->forward[i] && current->forward[i]->key < key) {
+                current = current->forward[i];
+            }
+        }
+        return current->forward[0];
+    }
+
+    void release_nodes() noexcept {
+        node* current = head_->forward[0];
+        while (current) {
+            node* next = current->forward[0];
+            delete current;
+            current = next;
+        }
+    }
+};
+
+} // namespace stl
+
+#endif // RADIX_SKIP_LIST_HPP
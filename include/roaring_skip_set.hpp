@@ -0,0 +1,698 @@
+/**
+ * @file roaring_skip_set.hpp
+ * @brief Множество 32-битных целых: список с пропусками по блокам и гибридные контейнеры
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef ROARING_SKIP_SET_HPP
+#define ROARING_SKIP_SET_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace stl {
+
+/**
+ * @brief Множество младших 16 битов ключей одного блока
+ *
+ * Хранится как отсортированный массив (до ARRAY_MAX элементов), битовая
+ * карта на 65536 битов или список отрезков - в зависимости от плотности.
+ * Изменение списка отрезков сначала переводит его в массив или карту;
+ * optimize() выбирает самое компактное представление.
+ */
+class chunk_container {
+public:
+    enum class kind { array, bitmap, run };
+
+    static constexpr uint32_t ARRAY_MAX = 4096;
+    static constexpr size_t WORDS = 65536 / 64;
+
+    /// Отрезок [start, start + length]
+    struct run {
+        uint16_t start;
+        uint16_t length;
+    };
+
+    kind type() const noexcept {
+        return kind_;
+    }
+
+    uint32_t cardinality() const noexcept {
+        return cardinality_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return cardinality_ == 0;
+    }
+
+    bool contains(uint16_t value) const {
+        switch (kind_) {
+        case kind::array:
+            return std::binary_search(array_.begin(), array_.end(), value);
+        case kind::bitmap:
+            return (bitmap_[value >> 6] >> (value & 63)) & 1;
+        case kind::run:
+            break;
+        }
+        auto it = std::upper_bound(runs_.begin(), runs_.end(), value,
+            [](uint16_t v, const run& r) { return v < r.start; });
+        return it != runs_.begin() && value <= std::prev(it)->start + std::prev(it)->length;
+    }
+
+    /// true, если значение добавлено
+    bool insert(uint16_t value) {
+        if (kind_ == kind::run) {
+            runs_to_plain();
+        }
+        if (kind_ == kind::bitmap) {
+            uint64_t& word = bitmap_[value >> 6];
+            uint64_t bit = uint64_t{1} << (value & 63);
+            if (word & bit) {
+                return false;
+            }
+            word |= bit;
+            ++cardinality_;
+            return true;
+        }
+
+        auto it = std::lower_bound(array_.begin(), array_.end(), value);
+        if (it != array_.end() && *it == value) {
+            return false;
+        }
+        if (cardinality_ == ARRAY_MAX) {
+            to_bitmap();
+            return insert(value);
+        }
+        array_.insert(it, value);
+        ++cardinality_;
+        return true;
+    }
+
+    /// true, если значение удалено
+    bool erase(uint16_t value) {
+        if (kind_ == kind::run) {
+            runs_to_plain();
+        }
+        if (kind_ == kind::bitmap) {
+            uint64_t& word = bitmap_[value >> 6];
+            uint64_t bit = uint64_t{1} << (value & 63);
+            if (!(word & bit)) {
+                return false;
+            }
+            word &= ~bit;
+            if (--cardinality_ <= ARRAY_MAX) {
+                to_array();
+            }
+            return true;
+        }
+
+        auto it = std::lower_bound(array_.begin(), array_.end(), value);
+        if (it == array_.end() || *it != value) {
+            return false;
+        }
+        array_.erase(it);
+        --cardinality_;
+        return true;
+    }
+
+    /// Число элементов, не превосходящих value
+    uint32_t rank(uint16_t value) const {
+        switch (kind_) {
+        case kind::array:
+            return static_cast<uint32_t>(
+                std::upper_bound(array_.begin(), array_.end(), value) - array_.begin());
+        case kind::bitmap: {
+            uint32_t count = 0;
+            size_t last = value >> 6;
+            for (size_t i = 0; i < last; ++i) {
+                count += static_cast<uint32_t>(std::popcount(bitmap_[i]));
+            }
+            uint64_t mask = (value & 63) == 63 ? ~uint64_t{0}
+                                               : (uint64_t{1} << ((value & 63) + 1)) - 1;
+            return count + static_cast<uint32_t>(std::popcount(bitmap_[last] & mask));
+        }
+        case kind::run:
+            break;
+        }
+        uint32_t count = 0;
+        for (const auto& r : runs_) {
+            if (r.start > value) {
+                break;
+            }
+            count += std::min<uint32_t>(value, r.start + r.length) - r.start + 1;
+        }
+        return count;
+    }
+
+    /// Наименьшее значение больше after (after = -1 дает первое); -1, если нет
+    int32_t next(int32_t after) const {
+        int32_t from = after + 1;
+        if (from > 0xFFFF) {
+            return -1;
+        }
+        switch (kind_) {
+        case kind::array: {
+            auto it = std::lower_bound(array_.begin(), array_.end(), static_cast<uint16_t>(from));
+            return it == array_.end() ? -1 : *it;
+        }
+        case kind::bitmap: {
+            size_t index = static_cast<size_t>(from) >> 6;
+            uint64_t word = bitmap_[index] & (~uint64_t{0} << (from & 63));
+            while (true) {
+                if (word) {
+                    return static_cast<int32_t>(index * 64 + std::countr_zero(word));
+                }
+                if (++index == WORDS) {
+                    return -1;
+                }
+                word = bitmap_[index];
+            }
+        }
+        case kind::run:
+            break;
+        }
+        auto it = std::upper_bound(runs_.begin(), runs_.end(), from,
+            [](int32_t v, const run& r) { return v < r.start; });
+        if (it != runs_.begin() && std::prev(it)->start + std::prev(it)->length >= from) {
+            return from;
+        }
+        return it == runs_.end() ? -1 : it->start;
+    }
+
+    template<typename F>
+    void for_each(F&& f) const {
+        for (int32_t value = next(-1); value >= 0; value = next(value)) {
+            f(static_cast<uint16_t>(value));
+        }
+    }
+
+    /// Переводит контейнер в самое компактное представление
+    void optimize() {
+        if (kind_ == kind::run) {
+            runs_to_plain();
+        }
+        std::vector<run> runs = collect_runs();
+        size_t plain_bytes = kind_ == kind::bitmap ? WORDS * sizeof(uint64_t)
+                                                   : cardinality_ * sizeof(uint16_t);
+        if (runs.size() * sizeof(run) < plain_bytes) {
+            runs_ = std::move(runs);
+            runs_.shrink_to_fit();
+            std::vector<uint16_t>().swap(array_);
+            std::vector<uint64_t>().swap(bitmap_);
+            kind_ = kind::run;
+        }
+    }
+
+    /// Байт, занятых данными контейнера
+    size_t memory_usage() const noexcept {
+        return sizeof(*this) + array_.capacity() * sizeof(uint16_t) +
+               bitmap_.capacity() * sizeof(uint64_t) + runs_.capacity() * sizeof(run);
+    }
+
+    static chunk_container intersect(const chunk_container& a, const chunk_container& b) {
+        if (a.kind_ == kind::run || b.kind_ == kind::run) {
+            return intersect(a.plain(), b.plain());
+        }
+
+        chunk_container result;
+        if (a.kind_ == kind::bitmap && b.kind_ == kind::bitmap) {
+            result.bitmap_.resize(WORDS);
+            result.kind_ = kind::bitmap;
+            and_words(a.bitmap_.data(), b.bitmap_.data(), result.bitmap_.data());
+            result.recount();
+            if (result.cardinality_ <= ARRAY_MAX) {
+                result.to_array();
+            }
+            return result;
+        }
+
+        const chunk_container& small = a.kind_ == kind::array ? a : b;
+        const chunk_container& other = &small == &a ? b : a;
+        for (uint16_t value : small.array_) {
+            if (other.contains(value)) {
+                result.array_.push_back(value);
+            }
+        }
+        result.cardinality_ = static_cast<uint32_t>(result.array_.size());
+        return result;
+    }
+
+    static chunk_container unite(const chunk_container& a, const chunk_container& b) {
+        if (a.kind_ == kind::run || b.kind_ == kind::run) {
+            return unite(a.plain(), b.plain());
+        }
+
+        chunk_container result;
+        if (a.kind_ == kind::array && b.kind_ == kind::array) {
+            std::set_union(a.array_.begin(), a.array_.end(), b.array_.begin(), b.array_.end(),
+                           std::back_inserter(result.array_));
+            result.cardinality_ = static_cast<uint32_t>(result.array_.size());
+            if (result.cardinality_ > ARRAY_MAX) {
+                result.to_bitmap();
+            }
+            return result;
+        }
+
+        result.kind_ = kind::bitmap;
+        result.bitmap_.resize(WORDS);
+        if (a.kind_ == kind::bitmap && b.kind_ == kind::bitmap) {
+            or_words(a.bitmap_.data(), b.bitmap_.data(), result.bitmap_.data());
+        } else {
+            const chunk_container& bitmap = a.kind_ == kind::bitmap ? a : b;
+            const chunk_container& array = &bitmap == &a ? b : a;
+            result.bitmap_ = bitmap.bitmap_;
+            for (uint16_t value : array.array_) {
+                result.bitmap_[value >> 6] |= uint64_t{1} << (value & 63);
+            }
+        }
+        result.recount();
+        return result;
+    }
+
+private:
+    // Пересечение и объединение битовых карт по 128 бит при наличии SSE2
+    static void and_words(const uint64_t* a, const uint64_t* b, uint64_t* out) noexcept {
+#ifdef __SSE2__
+        for (size_t i = 0; i < WORDS; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_and_si128(x, y));
+        }
+#else
+        for (size_t i = 0; i < WORDS; ++i) {
+            out[i] = a[i] & b[i];
+        }
+#endif
+    }
+
+    static void or_words(const uint64_t* a, const uint64_t* b, uint64_t* out) noexcept {
+#ifdef __SSE2__
+        for (size_t i = 0; i < WORDS; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(x, y));
+        }
+#else
+        for (size_t i = 0; i < WORDS; ++i) {
+            out[i] = a[i] | b[i];
+        }
+#endif
+    }
+
+    void recount() noexcept {
+        cardinality_ = 0;
+        for (uint64_t word : bitmap_) {
+            cardinality_ += static_cast<uint32_t>(std::popcount(word));
+        }
+    }
+
+    void to_bitmap() {
+        bitmap_.assign(WORDS, 0);
+        for (uint16_t value : array_) {
+            bitmap_[value >> 6] |= uint64_t{1} << (value & 63);
+        }
+        std::vector<uint16_t>().swap(array_);
+        kind_ = kind::bitmap;
+    }
+
+    void to_array() {
+        std::vector<uint16_t> values;
+        values.reserve(cardinality_);
+        for_each([&values](uint16_t value) { values.push_back(value); });
+        array_ = std::move(values);
+        std::vector<uint64_t>().swap(bitmap_);
+        kind_ = kind::array;
+    }
+
+    void runs_to_plain() {
+        std::vector<run> runs = std::move(runs_);
+        std::vector<run>().swap(runs_);
+        kind_ = kind::array;
+        if (cardinality_ > ARRAY_MAX) {
+            kind_ = kind::bitmap;
+            bitmap_.assign(WORDS, 0);
+        }
+        for (const auto& r : runs) {
+            for (uint32_t value = r.start; value <= uint32_t{r.start} + r.length; ++value) {
+                if (kind_ == kind::bitmap) {
+                    bitmap_[value >> 6] |= uint64_t{1} << (value & 63);
+                } else {
+                    array_.push_back(static_cast<uint16_t>(value));
+                }
+            }
+        }
+    }
+
+    std::vector<run> collect_runs() const {
+        std::vector<run> runs;
+        int32_t value = next(-1);
+        while (value >= 0) {
+            int32_t start = value;
+            int32_t last = value;
+            while ((value = next(last)) == last + 1) {
+                last = value;
+            }
+            runs.push_back({static_cast<uint16_t>(start), static_cast<uint16_t>(last - start)});
+        }
+        return runs;
+    }
+
+    chunk_container plain() const {
+        chunk_container copy = *this;
+        if (copy.kind_ == kind::run) {
+            copy.runs_to_plain();
+        }
+        return copy;
+    }
+
+    kind kind_ = kind::array;
+    uint32_t cardinality_ = 0;
+    std::vector<uint16_t> array_;
+    std::vector<uint64_t> bitmap_;
+    std::vector<run> runs_;
+};
+
+/**
+ * @brief Упорядоченное множество uint32_t в стиле Roaring
+ *
+ * skip_list индексирует блоки по старшим 16 битам ключа, а каждый блок
+ * хранит младшие биты в chunk_container. Плотные участки занимают
+ * единицы байтов на элемент вместо отдельного узла списка на каждое число.
+ *
+ * Каждый блок помнит число элементов в предыдущих блоках. Изменение
+ * помечает эти суммы устаревшими начиная с измененного блока, а rank()
+ * досчитывает их лениво, поэтому даже const-вызовы rank() нельзя
+ * выполнять параллельно.
+ */
+class roaring_skip_set {
+    struct chunk {
+        uint16_t high;
+        chunk_container container;
+        mutable size_t before = 0;   ///< элементов в предыдущих блоках
+    };
+
+    struct chunk_less {
+        bool operator()(const chunk& a, const chunk& b) const noexcept {
+            return a.high < b.high;
+        }
+    };
+
+    using chunk_list = skip_list<chunk, chunk_less>;
+
+public:
+    using value_type = uint32_t;
+    using size_type = std::size_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = const uint32_t&;
+
+        const_iterator() = default;
+
+        const_iterator(typename chunk_list::const_iterator chunk_it,
+                       typename chunk_list::const_iterator chunk_end, int32_t low)
+            : chunk_(chunk_it), chunk_end_(chunk_end), low_(low) {
+            settle();
+        }
+
+        reference operator*() const {
+            return value_;
+        }
+
+        pointer operator->() const {
+            return &value_;
+        }
+
+        const_iterator& operator++() {
+            low_ = chunk_->container.next(low_);
+            settle();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return chunk_ == other.chunk_ && (chunk_ == chunk_end_ || low_ == other.low_);
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        // Переходит к следующему блоку, если текущий исчерпан
+        void settle() {
+            while (chunk_ != chunk_end_ && low_ < 0) {
+                if (++chunk_ != chunk_end_) {
+                    low_ = chunk_->container.next(-1);
+                }
+            }
+            if (chunk_ != chunk_end_) {
+                value_ = (uint32_t{chunk_->high} << 16) | static_cast<uint32_t>(low_);
+            }
+        }
+
+        typename chunk_list::const_iterator chunk_;
+        typename chunk_list::const_iterator chunk_end_;
+        int32_t low_ = -1;
+        uint32_t value_ = 0;
+    };
+
+    using iterator = const_iterator;
+
+private:
+    chunk_list chunks_;
+    size_type size_ = 0;
+    // before верен у блоков со старшими битами меньше stale_from_ и у
+    // первого блока не меньше stale_from_; 0x10000 - все суммы верны
+    mutable uint32_t stale_from_ = 0x10000;
+
+public:
+    roaring_skip_set() = default;
+
+    roaring_skip_set(std::initializer_list<uint32_t> init) {
+        for (uint32_t value : init) {
+            insert(value);
+        }
+    }
+
+    // Итераторы
+    const_iterator begin() const {
+        auto first = chunks_.begin();
+        return const_iterator(first, chunks_.end(),
+                              first != chunks_.end() ? first->container.next(-1) : -1);
+    }
+
+    const_iterator end() const {
+        return const_iterator(chunks_.end(), chunks_.end(), -1);
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    /// Число блоков верхнего уровня
+    size_type chunk_count() const noexcept {
+        return chunks_.size();
+    }
+
+    /// Приблизительный объем памяти контейнеров и узлов списка в байтах
+    size_t memory_usage() const {
+        size_t bytes = sizeof(*this);
+        for (const auto& c : chunks_) {
+            bytes += c.container.memory_usage() + sizeof(SkipListNode<chunk>) +
+                     2 * sizeof(std::shared_ptr<SkipListNode<chunk>>);
+        }
+        return bytes;
+    }
+
+    // Модификаторы
+    bool insert(uint32_t value) {
+        auto it = chunks_.find(probe(value));
+        if (it == chunks_.end()) {
+            it = chunks_.insert(chunk{high(value), chunk_container()}).first;
+            stale_from_ = 0;
+        }
+        bool inserted = it->container.insert(low(value));
+        if (inserted) {
+            ++size_;
+            stale_from_ = std::min<uint32_t>(stale_from_, it->high);
+        }
+        return inserted;
+    }
+
+    size_type erase(uint32_t value) {
+        auto it = chunks_.find(probe(value));
+        if (it == chunks_.end() || !it->container.erase(low(value))) {
+            return 0;
+        }
+        stale_from_ = std::min<uint32_t>(stale_from_, it->high);
+        if (it->container.empty()) {
+            chunks_.erase(it);
+            stale_from_ = 0;
+        }
+        --size_;
+        return 1;
+    }
+
+    void clear() noexcept {
+        chunks_.clear();
+        size_ = 0;
+        stale_from_ = 0x10000;
+    }
+
+    /// Переводит каждый блок в самое компактное представление
+    void optimize() {
+        for (auto& c : chunks_) {
+            c.container.optimize();
+        }
+    }
+
+    // Поиск
+    bool contains(uint32_t value) const {
+        auto it = chunks_.find(probe(value));
+        return it != chunks_.end() && it->container.contains(low(value));
+    }
+
+    size_type count(uint32_t value) const {
+        return contains(value) ? 1 : 0;
+    }
+
+    /**
+     * @brief Число элементов, не превосходящих value
+     *
+     * Блок находится поиском по списку; суммы предыдущих блоков
+     * досчитываются только от первого измененного блока до найденного.
+     */
+    size_type rank(uint32_t value) const {
+        auto it = chunks_.lower_bound(probe(value));
+        if (it == chunks_.end()) {
+            return size_;
+        }
+        refresh_before(it);
+        return it->before + (it->high == high(value) ? it->container.rank(low(value)) : 0);
+    }
+
+    const_iterator lower_bound(uint32_t value) const {
+        auto it = chunks_.lower_bound(probe(value));
+        if (it == chunks_.end()) {
+            return end();
+        }
+        int32_t low_bound = it->high == high(value) ? it->container.next(int32_t{low(value)} - 1)
+                                                    : it->container.next(-1);
+        return const_iterator(it, chunks_.end(), low_bound);
+    }
+
+    // Операции над множествами
+    friend roaring_skip_set operator&(const roaring_skip_set& a, const roaring_skip_set& b) {
+        roaring_skip_set result;
+        auto x = a.chunks_.begin();
+        auto y = b.chunks_.begin();
+        while (x != a.chunks_.end() && y != b.chunks_.end()) {
+            if (x->high < y->high) {
+                ++x;
+            } else if (y->high < x->high) {
+                ++y;
+            } else {
+                result.append(x->high, chunk_container::intersect(x->container, y->container));
+                ++x;
+                ++y;
+            }
+        }
+        return result;
+    }
+
+    friend roaring_skip_set operator|(const roaring_skip_set& a, const roaring_skip_set& b) {
+        roaring_skip_set result;
+        auto x = a.chunks_.begin();
+        auto y = b.chunks_.begin();
+        while (x != a.chunks_.end() || y != b.chunks_.end()) {
+            if (y == b.chunks_.end() || (x != a.chunks_.end() && x->high < y->high)) {
+                result.append(x->high, x->container);
+                ++x;
+            } else if (x == a.chunks_.end() || y->high < x->high) {
+                result.append(y->high, y->container);
+                ++y;
+            } else {
+                result.append(x->high, chunk_container::unite(x->container, y->container));
+                ++x;
+                ++y;
+            }
+        }
+        return result;
+    }
+
+    friend bool operator==(const roaring_skip_set& a, const roaring_skip_set& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+private:
+    static uint16_t high(uint32_t value) noexcept {
+        return static_cast<uint16_t>(value >> 16);
+    }
+
+    static uint16_t low(uint32_t value) noexcept {
+        return static_cast<uint16_t>(value & 0xFFFF);
+    }
+
+    static chunk probe(uint32_t value) {
+        return chunk{high(value), chunk_container()};
+    }
+
+    void append(uint16_t high_bits, chunk_container container) {
+        if (container.empty()) {
+            return;
+        }
+        size_ += container.cardinality();
+        chunks_.insert(chunk{high_bits, std::move(container)});
+        stale_from_ = 0;
+    }
+
+    // Досчитывает before от первого устаревшего блока до target
+    void refresh_before(typename chunk_list::const_iterator target) const {
+        if (target->high < stale_from_) {
+            return;
+        }
+        auto it = stale_from_ == 0 ? chunks_.begin()
+                                   : chunks_.lower_bound(chunk{static_cast<uint16_t>(stale_from_),
+                                                               chunk_container()});
+        if (stale_from_ == 0) {
+            it->before = 0;
+        }
+        while (it != target) {
+            size_t through = it->before + it->container.cardinality();
+            (++it)->before = through;
+        }
+        stale_from_ = target->high;
+    }
+};
+
+} // namespace stl
+
+#endif // ROARING_SKIP_SET_HPP
@@ -10,13 +10,20 @@
 #define SKIP_LIST_HPP
 
 #include <memory>
+#include <mutex>
+#include <new>
 #include <random>
 #include <stdexcept>
 #include <type_traits>
 #include <concepts>
 #include <iterator>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace stl {
@@ -41,6 +48,130 @@ struct SkipListNode {
     }
 };
 
+namespace detail {
+
+/**
+ * @brief Итеративно освобождает цепочки узлов из work
+ *
+ * Рекурсивное разрушение цепочки shared_ptr переполняет стек на длинных
+ * списках, поэтому цепочка обходится по уровню 0, а ссылки верхних
+ * уровней, оказавшиеся единственными, переносятся в work. Обход цепочки
+ * останавливается на узле, на который есть другие ссылки (итератор или
+ * живой список): его освободит последний владелец. После limit узлов
+ * необработанные остатки остаются в work.
+ *
+ * @return Число освобожденных узлов
+ */
+template<typename Node>
+size_t release_chains(std::vector<std::shared_ptr<Node>>& work, size_t limit) {
+    size_t released = 0;
+    while (released < limit && !work.empty()) {
+        std::shared_ptr<Node> node = std::move(work.back());
+        work.pop_back();
+
+        while (node && released < limit) {
+            if (node.use_count() > 1) {
+                node.reset();
+                break;
+            }
+            for (size_t i = 1; i < node->forward.size(); ++i) {
+                if (node->forward[i].use_count() == 1) {
+                    work.push_back(std::move(node->forward[i]));
+                }
+            }
+            std::shared_ptr<Node> next = std::move(node->forward[0]);
+            node.reset();
+            node = std::move(next);
+            ++released;
+        }
+        if (node) {
+            work.push_back(std::move(node));
+        }
+    }
+    return released;
+}
+
+/**
+ * @brief Очередь отсоединенных цепочек для освобождения вне потока списка
+ *
+ * Список кладет цепочки, а задача task_executor освобождает их
+ * пачками. Очередь разделяется через shared_ptr, поэтому переживает
+ * список, если тот разрушен раньше, чем освобождены его узлы.
+ */
+template<typename Node>
+class release_queue {
+public:
+    /**
+     * @brief Добавляет цепочку; при нехватке памяти chain остается у вызывающего
+     * @return true, если освобождающая задача еще не запланирована
+     */
+    bool push(std::shared_ptr<Node>& chain) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chains_.push_back(std::move(chain));
+        bool schedule = !scheduled_;
+        scheduled_ = true;
+        return schedule;
+    }
+
+    /// Освобождает не более limit узлов; false, когда очередь опустела
+    bool release(size_t limit) {
+        size_t released = 0;
+        std::vector<std::shared_ptr<Node>> work;
+        while (released < limit) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::move(work.begin(), work.end(), std::back_inserter(chains_));
+                work.clear();
+                if (chains_.empty()) {
+                    scheduled_ = false;
+                    return false;
+                }
+                work.push_back(std::move(chains_.back()));
+                chains_.pop_back();
+            }
+            released += release_chains(work, limit - released);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::move(work.begin(), work.end(), std::back_inserter(chains_));
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<Node>> chains_;
+    bool scheduled_ = false;
+};
+
+/**
+ * @brief Маска полос, в которых next[l] < query[l]
+ *
+ * С расширениями GCC все полосы сравниваются одной векторной операцией,
+ * иначе - поэлементно.
+ */
+template<typename T, size_t Lanes>
+unsigned lanes_less(const T (&next)[Lanes], const T (&query)[Lanes]) noexcept {
+    unsigned mask = 0;
+#if defined(__GNUC__)
+    typedef T lane_vector __attribute__((vector_size(Lanes * sizeof(T))));
+    lane_vector a;
+    lane_vector b;
+    std::memcpy(&a, next, sizeof(a));
+    std::memcpy(&b, query, sizeof(b));
+    auto less = a < b;
+    for (size_t l = 0; l < Lanes; ++l) {
+        mask |= static_cast<unsigned>(less[l] != 0) << l;
+    }
+#else
+    for (size_t l = 0; l < Lanes; ++l) {
+        mask |= static_cast<unsigned>(next[l] < query[l]) << l;
+    }
+#endif
+    return mask;
+}
+
+} // namespace detail
+
 template<typename T, bool IsConst = false>
 class SkipListIterator {
 public:
@@ -103,6 +234,56 @@ public:
     NodePtr get_node() const { return current_; }
 };
 
+/**
+ * @brief Исполнитель фоновых задач, которому skip_list передает освобождение узлов
+ *
+ * Задача вызывается повторно с крайним сроком кванта и возвращает true,
+ * пока работа осталась. Реализация с фоновым потоком - maintenance_executor
+ * (см. maintenance_executor.hpp).
+ */
+class task_executor {
+public:
+    using clock = std::chrono::steady_clock;
+    using task = std::function<bool(clock::time_point)>;
+
+    virtual void post(task t) = 0;
+
+protected:
+    ~task_executor() = default;
+};
+
+/**
+ * @brief Наблюдатель изменений содержимого списка
+ *
+ * Список сообщает о каждой вставке и удалении и перед каждой очисткой.
+ * Наблюдатель переходит вместе с содержимым при перемещении и swap и
+ * узнает новый список из on_attach(). Журнал изменений и дамп в файл -
+ * наблюдатели из change_feed.hpp и skip_list_dump.hpp, поэтому сам
+ * skip_list не зависит от потоков и файлов.
+ */
+template<typename List>
+class skip_list_observer {
+public:
+    /// Наблюдатель подключен к list или перешел к нему вместе с содержимым
+    virtual void on_attach(List& list) = 0;
+
+    /// Вставлен элемент *inserted
+    virtual void on_insert(typename List::iterator inserted) = 0;
+
+    /// Элемент *erased снят со списка; узел жив до возврата
+    virtual void on_erase(typename List::iterator erased) = 0;
+
+    /// Список будет очищен; содержимое еще доступно
+    virtual void on_clear() noexcept = 0;
+
+    /// Список больше не сообщает об изменениях: наблюдатель отключен,
+    /// список разрушен или заменен присваиванием
+    virtual void on_detach() noexcept = 0;
+
+protected:
+    ~skip_list_observer() = default;
+};
+
 template<typename T, 
          typename Compare = std::less<T>,
          typename Allocator = std::allocator<T>>
@@ -124,6 +305,19 @@ public:
     using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
     using iterator = SkipListIterator<T, false>;
     using const_iterator = SkipListIterator<T, true>;
+    using observer_type = skip_list_observer<skip_list>;
+
+    /**
+     * @brief Позиция пошаговой процедуры обслуживания (rebuild_towers, compact)
+     *
+     * Хранит ключ следующего необработанного узла, а не указатель на него,
+     * поэтому между шагами список можно свободно изменять.
+     */
+    struct maintenance_cursor {
+        std::optional<value_type> key;
+        size_type rank = 0;
+        bool done = false;
+    };
 
 private:
     using Node = SkipListNode<T>;
@@ -137,6 +331,17 @@ private:
     allocator_type alloc_;
     std::mt19937 gen_;
     std::uniform_real_distribution<double> dist_;
+    bool deferred_release_ = false;
+    std::vector<NodePtr> retired_;
+    task_executor* release_executor_ = nullptr;
+    std::shared_ptr<detail::release_queue<Node>> release_queue_;
+    size_type index_level_ = 0;
+    std::vector<value_type> index_keys_;
+    std::vector<NodePtr> index_nodes_;
+    std::vector<observer_type*> observers_;
+
+    static constexpr size_type RELEASE_BATCH = 256;
+    static constexpr size_type BATCH_LANES = 8;
 
 public:
     skip_list() : skip_list(Compare(), Allocator()) {}
@@ -152,6 +357,7 @@ public:
 
     skip_list(const skip_list& other)
         : skip_list(other.comp_, other.alloc_) {
+        index_level_ = other.index_level_;
         for (const auto& value : other) {
             insert(value);
         }
@@ -161,9 +367,16 @@ public:
         : head_(std::move(other.head_)), size_(other.size_), 
           max_level_(other.max_level_), comp_(std::move(other.comp_)),
           alloc_(std::move(other.alloc_)), gen_(std::move(other.gen_)),
-          dist_(std::move(other.dist_)) {
+          dist_(std::move(other.dist_)), deferred_release_(other.deferred_release_),
+          retired_(std::move(other.retired_)), release_executor_(other.release_executor_),
+          release_queue_(std::move(other.release_queue_)), index_level_(other.index_level_),
+          index_keys_(std::move(other.index_keys_)), index_nodes_(std::move(other.index_nodes_)),
+          observers_(std::move(other.observers_)) {
         other.size_ = 0;
         other.max_level_ = 0;
+        other.release_executor_ = nullptr;
+        other.observers_.clear();
+        attach_observers();
     }
 
     skip_list(std::initializer_list<value_type> init,
@@ -175,7 +388,23 @@ public:
         }
     }
 
-    ~skip_list() = default;
+    /// Без исполнителя освобождает узлы итеративно, с ним - передает их задаче
+    ~skip_list() {
+        detach_observers();
+        index_nodes_.clear();
+        if (head_) {
+            NodePtr chain = std::move(head_->forward[0]);
+            head_->forward.clear();
+            retire_chain(std::move(chain));
+        }
+        if (release_executor_) {
+            for (auto& chain : retired_) {
+                retire_chain(std::move(chain));
+            }
+        } else {
+            detail::release_chains(retired_, static_cast<size_t>(-1));
+        }
+    }
 
     skip_list& operator=(const skip_list& other) {
         if (this != &other) {
@@ -185,8 +414,10 @@ public:
         return *this;
     }
 
+    /// Наблюдатели *this отключаются, наблюдатели other переходят к *this
     skip_list& operator=(skip_list&& other) noexcept {
         if (this != &other) {
+            detach_observers();
             clear();
             head_ = std::move(other.head_);
             size_ = other.size_;
@@ -195,6 +426,17 @@ public:
             alloc_ = std::move(other.alloc_);
             gen_ = std::move(other.gen_);
             dist_ = std::move(other.dist_);
+            deferred_release_ = other.deferred_release_;
+            std::move(other.retired_.begin(), other.retired_.end(), std::back_inserter(retired_));
+            other.retired_.clear();
+            release_executor_ = std::exchange(other.release_executor_, nullptr);
+            release_queue_ = std::move(other.release_queue_);
+            index_level_ = other.index_level_;
+            index_keys_ = std::move(other.index_keys_);
+            index_nodes_ = std::move(other.index_nodes_);
+            observers_ = std::move(other.observers_);
+            other.observers_.clear();
+            attach_observers();
             other.size_ = 0;
             other.max_level_ = 0;
         }
@@ -230,6 +472,21 @@ public:
         return const_iterator(nullptr);
     }
 
+    // Доступ к элементам
+    reference front() {
+        if (empty()) {
+            throw std::out_of_range("front() on empty skip_list");
+        }
+        return head_->forward[0]->value;
+    }
+
+    const_reference front() const {
+        if (empty()) {
+            throw std::out_of_range("front() on empty skip_list");
+        }
+        return head_->forward[0]->value;
+    }
+
     // Емкость
     [[nodiscard]] bool empty() const noexcept {
         return size_ == 0;
@@ -245,10 +502,17 @@ public:
 
     // Модификаторы
     void clear() noexcept {
+        for (observer_type* observer : observers_) {
+            observer->on_clear();
+        }
+        index_keys_.clear();
+        index_nodes_.clear();
+        NodePtr chain = std::move(head_->forward[0]);
         head_->forward.clear();
         head_->forward.resize(MAX_LEVEL);
         size_ = 0;
         max_level_ = 0;
+        retire_chain(std::move(chain));
     }
 
     std::pair<iterator, bool> insert(const value_type& value) {
@@ -264,6 +528,29 @@ public:
         return insert(value_type(std::forward<Args>(args)...));
     }
 
+    iterator erase(iterator pos) {
+        if (pos == end()) {
+            throw std::out_of_range("Erasing end iterator");
+        }
+        return iterator(erase_impl(*pos));
+    }
+
+    size_type erase(const value_type& key) {
+        size_type old_size = size_;
+        erase_impl(key);
+        return old_size - size_;
+    }
+
+    /// Удаляет наименьший элемент
+    void pop_front() {
+        if (empty()) {
+            throw std::out_of_range("pop_front() on empty skip_list");
+        }
+        // Узел удерживается, пока erase_impl сравнивает с его значением
+        NodePtr first = head_->forward[0];
+        erase_impl(first->value);
+    }
+
     void swap(skip_list& other) noexcept(
         std::allocator_traits<Allocator>::is_always_equal::value &&
         std::is_nothrow_swappable_v<Compare>) {
@@ -274,6 +561,16 @@ public:
         std::swap(alloc_, other.alloc_);
         std::swap(gen_, other.gen_);
         std::swap(dist_, other.dist_);
+        std::swap(deferred_release_, other.deferred_release_);
+        std::swap(retired_, other.retired_);
+        std::swap(release_executor_, other.release_executor_);
+        std::swap(release_queue_, other.release_queue_);
+        std::swap(index_level_, other.index_level_);
+        std::swap(index_keys_, other.index_keys_);
+        std::swap(index_nodes_, other.index_nodes_);
+        std::swap(observers_, other.observers_);
+        attach_observers();
+        other.attach_observers();
     }
 
     // Поиск
@@ -282,25 +579,17 @@ public:
     }
 
     const_iterator find(const value_type& key) const {
-        NodePtr current = head_;
-
-        for (int i = max_level_; i >= 0; --i) {
-            while (current->forward[i] && comp_(current->forward[i]->value, key)) {
-                current = current->forward[i];
-            }
-        }
-
-        current = current->forward[0];
-
-        if (current && !comp_(key, current->value) && !comp_(current->value, key)) {
-            return const_iterator(current);
+        const NodePtr& candidate = bound_link(key, false);
+        if (candidate && !comp_(key, candidate->value)) {
+            return const_iterator(candidate);
         }
 
         return const_iterator(nullptr);
     }
 
     size_type count(const value_type& key) const {
-        return find(key) != end() ? 1 : 0;
+        const NodePtr& candidate = bound_link(key, false);
+        return candidate && !comp_(key, candidate->value) ? 1 : 0;
     }
 
     iterator lower_bound(const value_type& key) {
@@ -308,15 +597,7 @@ public:
     }
 
     const_iterator lower_bound(const value_type& key) const {
-        NodePtr current = head_;
-
-        for (int i = max_level_; i >= 0; --i) {
-            while (current->forward[i] && comp_(current->forward[i]->value, key)) {
-                current = current->forward[i];
-            }
-        }
-
-        return const_iterator(current->forward[0]);
+        return const_iterator(lower_bound_impl(key).get_node());
     }
 
     iterator upper_bound(const value_type& key) {
@@ -324,15 +605,7 @@ public:
     }
 
     const_iterator upper_bound(const value_type& key) const {
-        NodePtr current = head_;
-
-        for (int i = max_level_; i >= 0; --i) {
-            while (current->forward[i] && !comp_(key, current->forward[i]->value)) {
-                current = current->forward[i];
-            }
-        }
-
-        return const_iterator(current->forward[0]);
+        return const_iterator(upper_bound_node(key));
     }
 
     std::pair<iterator, iterator> equal_range(const value_type& key) {
@@ -343,12 +616,247 @@ public:
         return {lower_bound(key), upper_bound(key)};
     }
 
+    /**
+     * @brief Пакетный поиск целых ключей
+     *
+     * Запросы спускаются по списку группами по BATCH_LANES: на каждом
+     * уровне ключи следующих узлов всех полос сравниваются с ключами
+     * запросов одной векторной операцией, и каждая полоса по своей маске
+     * либо шагает вправо, либо ждет остальных. Спуск идет по сырым
+     * указателям без копирования shared_ptr. Для компаратора, отличного от
+     * std::less, выполняется обычный find.
+     *
+     * @return Итераторы найденных элементов или end() в порядке keys
+     */
+    std::vector<const_iterator> find_batch(const std::vector<value_type>& keys) const
+        requires(std::integral<T> && !std::same_as<T, bool>) {
+        std::vector<const_iterator> result(keys.size());
+        for (size_type first = 0; first < keys.size(); first += BATCH_LANES) {
+            size_type count = std::min(BATCH_LANES, keys.size() - first);
+            if constexpr (std::is_same_v<Compare, std::less<T>>) {
+                find_lanes(keys.data() + first, count, result.data() + first);
+            } else {
+                for (size_type l = 0; l < count; ++l) {
+                    result[first + l] = find(keys[first + l]);
+                }
+            }
+        }
+        return result;
+    }
+
     // Наблюдатели
     value_compare value_comp() const {
         return comp_;
     }
 
+    // Обслуживание (см. maintenance_executor.hpp)
+
+    /**
+     * @brief Откладывает освобождение узлов, удаленных erase и clear
+     *
+     * Удаленные узлы копятся до вызова release_retired(), который можно
+     * выполнять в моменты простоя, а не на пути запроса.
+     */
+    void set_deferred_release(bool enabled) noexcept {
+        deferred_release_ = enabled;
+    }
+
+    /**
+     * @brief Передает освобождение удаленных узлов исполнителю
+     *
+     * erase, clear и деструктор лишь ставят отсоединенные цепочки в
+     * очередь, а задача executor освобождает их пачками по RELEASE_BATCH
+     * узлов, поэтому уничтожение большого списка занимает микросекунды.
+     * Исполнитель должен пережить список; nullptr отключает передачу.
+     */
+    void set_release_executor(task_executor* executor) {
+        release_executor_ = executor;
+        if (executor && !release_queue_) {
+            release_queue_ = std::make_shared<detail::release_queue<Node>>();
+        }
+    }
+
+    bool has_retired() const noexcept {
+        return !retired_.empty();
+    }
+
+    /**
+     * @brief Освобождает не более limit отложенных узлов
+     *
+     * Цепочки освобождаются итеративно по уровню 0; узел, на который еще
+     * ссылается итератор, освобождается вместе с последним итератором.
+     *
+     * @return Число освобожденных узлов
+     */
+    size_type release_retired(size_type limit) {
+        size_type released = detail::release_chains(retired_, limit);
+        if (retired_.empty()) {
+            retired_.shrink_to_fit();
+        }
+        return released;
+    }
+
+    /**
+     * @brief Включает кэш верхних уровней в непрерывных массивах
+     *
+     * Ключи узлов высоты не ниже min_level копируются подряд в порядке
+     * возрастания вместе с указателями на узлы. Поиск выбирает в них
+     * двоичным поиском ближайший предшествующий узел и спускается от него
+     * с уровня min_level - 1, не обходя разбросанные по куче верхние
+     * уровни. Вставка и удаление узла такой высоты добавляют или убирают
+     * одну запись кэша, но сдвигают массивы за ней: O(размер кэша) на
+     * каждый высокий узел. 0 выключает кэш.
+     */
+    void set_index_cache(size_type min_level) {
+        static_assert(std::is_copy_constructible_v<T>, "Index cache stores copies of keys");
+        if (min_level >= MAX_LEVEL) {
+            throw std::out_of_range("Index cache level exceeds MAX_LEVEL");
+        }
+        index_level_ = min_level;
+        std::vector<value_type>().swap(index_keys_);
+        std::vector<NodePtr>().swap(index_nodes_);
+        if (min_level == 0) {
+            return;
+        }
+        for (NodePtr node = head_->forward[min_level]; node; node = node->forward[min_level]) {
+            index_keys_.push_back(node->value);
+            index_nodes_.push_back(node);
+        }
+    }
+
+    size_type index_cache_level() const noexcept {
+        return index_level_;
+    }
+
+    /// Число узлов в кэше верхних уровней
+    size_type index_cache_size() const noexcept {
+        return index_nodes_.size();
+    }
+
+    /**
+     * @brief Перестраивает башни не более чем limit узлов, начиная с cursor
+     *
+     * Узлу с порядковым номером r назначается высота, равная числу раз,
+     * которое 1/P делит r, что восстанавливает идеальное распределение
+     * уровней после серии удалений. Узлы не перевыделяются, итераторы
+     * остаются действительными.
+     *
+     * @return Число обработанных узлов
+     */
+    size_type rebuild_towers(maintenance_cursor& cursor, size_type limit) {
+        std::vector<NodePtr> update(MAX_LEVEL, head_);
+        NodePtr current = cursor_start(cursor, update);
+        size_type processed = 0;
+
+        for (; current && processed < limit; ++processed) {
+            size_type level = tower_level(++cursor.rank);
+            size_type old_level = current->level;
+            advance_predecessors(update, current->value, std::max(level, old_level));
+
+            for (size_type i = level + 1; i <= old_level; ++i) {
+                update[i]->forward[i] = current->forward[i];
+            }
+            current->forward.resize(level + 1);
+            for (size_type i = old_level + 1; i <= level; ++i) {
+                current->forward[i] = update[i]->forward[i];
+                update[i]->forward[i] = current;
+            }
+            current->level = level;
+            max_level_ = std::max(max_level_, level);
+            if (index_level_ != 0 && (old_level >= index_level_) != (level >= index_level_)) {
+                if (level >= index_level_) {
+                    index_insert(current);
+                } else {
+                    index_erase(current);
+                }
+            }
+
+            for (size_type i = 0; i <= level; ++i) {
+                update[i] = current;
+            }
+            current = current->forward[0];
+        }
+
+        cursor_finish(cursor, current);
+        return processed;
+    }
+
+    /**
+     * @brief Переразмещает не более limit узлов в порядке ключей
+     *
+     * Узлы выделяются заново подряд, чтобы соседние по ключу элементы
+     * оказались рядом в памяти; итоговое размещение определяет
+     * распределитель. Итераторы на перемещенные узлы становятся
+     * недействительными.
+     *
+     * @return Число перемещенных узлов
+     */
+    size_type compact(maintenance_cursor& cursor, size_type limit) {
+        std::vector<NodePtr> update(MAX_LEVEL, head_);
+        NodePtr current = cursor_start(cursor, update);
+        std::vector<NodePtr> old_nodes;
+        old_nodes.reserve(limit);
+
+        while (current && old_nodes.size() < limit) {
+            advance_predecessors(update, current->value, current->level);
+
+            auto fresh = std::make_shared<Node>(std::move(current->value), current->level);
+            fresh->forward = current->forward;
+            for (size_type i = 0; i <= current->level; ++i) {
+                update[i]->forward[i] = fresh;
+                update[i] = fresh;
+            }
+            if (index_level_ != 0 && fresh->level >= index_level_) {
+                index_nodes_[index_position(fresh->value)] = fresh;
+            }
+
+            old_nodes.push_back(std::move(current));
+            current = fresh->forward[0];
+        }
+
+        cursor_finish(cursor, current);
+        return old_nodes.size();
+    }
+
+    // Наблюдатели
+
+    /**
+     * @brief Подключает наблюдателя изменений
+     *
+     * Наблюдатель должен отключиться remove_observer() или пережить
+     * список. Копирование списка наблюдателей не переносит.
+     */
+    void add_observer(observer_type* observer) {
+        observers_.push_back(observer);
+        observer->on_attach(*this);
+    }
+
+    void remove_observer(observer_type* observer) noexcept {
+        auto it = std::find(observers_.begin(), observers_.end(), observer);
+        if (it != observers_.end()) {
+            observers_.erase(it);
+            observer->on_detach();
+        }
+    }
+
 private:
+    // Первый узел больше key
+    NodePtr upper_bound_node(const value_type& key) const {
+        return bound_link(key, true);
+    }
+
+    void attach_observers() {
+        for (observer_type* observer : observers_) {
+            observer->on_attach(*this);
+        }
+    }
+
+    void detach_observers() noexcept {
+        for (observer_type* observer : std::exchange(observers_, {})) {
+            observer->on_detach();
+        }
+    }
+
     size_type random_level() {
         size_type level = 0;
         while (dist_(gen_) < P && level < MAX_LEVEL - 1) {
@@ -360,9 +868,9 @@ private:
     template<typename U>
     std::pair<iterator, bool> insert_impl(U&& value) {
         std::vector<NodePtr> update(MAX_LEVEL, head_);
-        NodePtr current = head_;
+        auto [current, top] = search_entry(value);
 
-        for (int i = max_level_; i >= 0; --i) {
+        for (int i = top; i >= 0; --i) {
             while (current->forward[i] && comp_(current->forward[i]->value, value)) {
                 current = current->forward[i];
             }
@@ -376,6 +884,9 @@ private:
         }
 
         size_type new_level = random_level();
+        if (static_cast<int>(new_level) > top) {
+            upper_predecessors(value, update, top);
+        }
         if (new_level > max_level_) {
             for (size_type i = max_level_ + 1; i <= new_level; ++i) {
                 update[i] = head_;
@@ -389,51 +900,288 @@ private:
             new_node->forward[i] = update[i]->forward[i];
             update[i]->forward[i] = new_node;
         }
+        if (index_level_ != 0 && new_level >= index_level_) {
+            index_insert(new_node);
+        }
 
         ++size_;
+        for (observer_type* observer : observers_) {
+            observer->on_insert(iterator(new_node));
+        }
         return {iterator(new_node), true};
     }
 
-    iterator find_impl(const value_type& key) const {
-        NodePtr current = head_;
+    // Возвращает узел, следующий за удаленным (или за позицией ключа)
+    NodePtr erase_impl(const value_type& key) {
+        std::vector<NodePtr> update(MAX_LEVEL, head_);
+        auto [current, top] = search_entry(key);
 
-        for (int i = max_level_; i >= 0; --i) {
+        for (int i = top; i >= 0; --i) {
             while (current->forward[i] && comp_(current->forward[i]->value, key)) {
                 current = current->forward[i];
             }
+            update[i] = current;
         }
 
         current = current->forward[0];
 
-        if (current && !comp_(key, current->value) && !comp_(current->value, key)) {
-            return iterator(current);
+        if (!current || comp_(key, current->value)) {
+            return current;
+        }
+        if (static_cast<int>(current->level) > top) {
+            upper_predecessors(key, update, top);
+        }
+        if (index_level_ != 0 && current->level >= index_level_) {
+            index_erase(current);
+        }
+
+        for (size_type i = 0; i <= current->level; ++i) {
+            if (update[i]->forward[i] == current) {
+                update[i]->forward[i] = current->forward[i];
+            }
+        }
+
+        while (max_level_ > 0 && !head_->forward[max_level_]) {
+            --max_level_;
         }
 
-        return iterator(nullptr);
+        --size_;
+        for (observer_type* observer : observers_) {
+            observer->on_erase(iterator(current));
+        }
+        NodePtr next = current->forward[0];
+        // Одиночный узел ссылается только на живые узлы и освобождается
+        // без каскада, поэтому без отложенного режима его отпускаем сразу
+        if (release_executor_ || deferred_release_) {
+            retire_chain(std::move(current));
+        }
+        return next;
     }
 
-    iterator lower_bound_impl(const value_type& key) const {
-        NodePtr current = head_;
+    // Освобождает отсоединенную цепочку сразу, откладывает ее или передает
+    // исполнителю в зависимости от настроек списка. Если памяти под очередь
+    // не хватило, цепочка освобождается сразу
+    void retire_chain(NodePtr chain) noexcept {
+        if (!chain) {
+            return;
+        }
+        try {
+            if (release_executor_) {
+                if (release_queue_->push(chain)) {
+                    post_release_task();
+                }
+                return;
+            }
+            if (deferred_release_) {
+                retired_.push_back(std::move(chain));
+                return;
+            }
+        } catch (const std::bad_alloc&) {
+            if (!chain) {
+                release_queue_->release(static_cast<size_t>(-1));
+            }
+        }
+        release_now(std::move(chain));
+    }
 
+    static void release_now(NodePtr chain) noexcept {
+        if (!chain || chain.use_count() > 1) {
+            return;
+        }
+        try {
+            std::vector<NodePtr> work;
+            work.push_back(std::move(chain));
+            detail::release_chains(work, static_cast<size_t>(-1));
+        } catch (const std::bad_alloc&) {
+        }
+    }
+
+    void post_release_task() {
+        release_executor_->post([queue = release_queue_](auto deadline) {
+            while (queue->release(RELEASE_BATCH)) {
+                if (task_executor::clock::now() >= deadline) {
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    size_type tower_level(size_type rank) const noexcept {
+        const auto fanout = static_cast<size_type>(1.0 / P);
+        size_type level = 0;
+        while (rank % fanout == 0 && level < MAX_LEVEL - 1) {
+            rank /= fanout;
+            ++level;
+        }
+        return level;
+    }
+
+    // Заполняет update предшественниками ключа курсора и возвращает первый
+    // необработанный узел
+    NodePtr cursor_start(const maintenance_cursor& cursor, std::vector<NodePtr>& update) const {
+        if (cursor.done) {
+            return nullptr;
+        }
+        if (!cursor.key) {
+            return head_->forward[0];
+        }
+
+        NodePtr current = head_;
         for (int i = max_level_; i >= 0; --i) {
-            while (current->forward[i] && comp_(current->forward[i]->value, key)) {
+            while (current->forward[i] && comp_(current->forward[i]->value, *cursor.key)) {
                 current = current->forward[i];
             }
+            update[i] = current;
         }
+        return current->forward[0];
+    }
 
-        return iterator(current->forward[0]);
+    void cursor_finish(maintenance_cursor& cursor, const NodePtr& next) {
+        if (next) {
+            cursor.key = next->value;
+            return;
+        }
+        cursor.key.reset();
+        cursor.done = true;
+        while (max_level_ > 0 && !head_->forward[max_level_]) {
+            --max_level_;
+        }
     }
 
-    iterator upper_bound_impl(const value_type& key) const {
+    // Сдвигает предшественников уровней 0..top к последним узлам меньше key
+    void advance_predecessors(std::vector<NodePtr>& update, const value_type& key,
+                              size_type top) const {
+        for (size_type i = 0; i <= top; ++i) {
+            while (update[i]->forward[i] && comp_(update[i]->forward[i]->value, key)) {
+                update[i] = update[i]->forward[i];
+            }
+        }
+    }
+
+    // Узел и уровень, с которых начинается спуск к key. С кэшем верхних
+    // уровней это последний кэшированный узел меньше key (не больше key
+    // при inclusive) и уровень index_level_ - 1: узлов такой высоты между
+    // ним и key нет
+    std::pair<NodePtr, int> search_entry(const value_type& key, bool inclusive = false) const {
+        auto [entry, top] = entry_link(key, inclusive);
+        return {*entry, top};
+    }
+
+    std::pair<const NodePtr*, int> entry_link(const value_type& key, bool inclusive) const {
+        if (index_level_ == 0 || max_level_ < index_level_) {
+            return {&head_, static_cast<int>(max_level_)};
+        }
+        auto it = inclusive
+            ? std::upper_bound(index_keys_.begin(), index_keys_.end(), key, comp_)
+            : std::lower_bound(index_keys_.begin(), index_keys_.end(), key, comp_);
+        auto position = it - index_keys_.begin();
+        return {position == 0 ? &head_ : &index_nodes_[position - 1],
+                static_cast<int>(index_level_) - 1};
+    }
+
+    // Связь уровня 0, ведущая к первому узлу не меньше key (больше key при
+    // inclusive). Спуск идет по сырым указателям: поиск не копирует
+    // shared_ptr и не трогает счетчики ссылок пройденных узлов
+    const NodePtr& bound_link(const value_type& key, bool inclusive) const {
+        auto [entry, top] = entry_link(key, inclusive);
+        const Node* current = entry->get();
+
+        for (int i = top; i >= 0; --i) {
+            for (const Node* next = current->forward[i].get();
+                 next && (inclusive ? !comp_(key, next->value) : comp_(next->value, key));
+                 next = current->forward[i].get()) {
+                current = next;
+            }
+        }
+
+        return current->forward[0];
+    }
+
+    // Заполняет update на уровнях выше top обычным спуском от головы
+    void upper_predecessors(const value_type& key, std::vector<NodePtr>& update, int top) const {
         NodePtr current = head_;
+        for (int i = max_level_; i > top; --i) {
+            while (current->forward[i] && comp_(current->forward[i]->value, key)) {
+                current = current->forward[i];
+            }
+            update[i] = current;
+        }
+    }
+
+    size_type index_position(const value_type& key) const {
+        return static_cast<size_type>(
+            std::lower_bound(index_keys_.begin(), index_keys_.end(), key, comp_) -
+            index_keys_.begin());
+    }
+
+    void index_insert(const NodePtr& node) {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            size_type position = index_position(node->value);
+            index_keys_.insert(index_keys_.begin() + position, node->value);
+            index_nodes_.insert(index_nodes_.begin() + position, node);
+        }
+    }
+
+    void index_erase(const NodePtr& node) {
+        size_type position = index_position(node->value);
+        if (position < index_nodes_.size() && index_nodes_[position] == node) {
+            index_keys_.erase(index_keys_.begin() + position);
+            index_nodes_.erase(index_nodes_.begin() + position);
+        }
+    }
+
+    // Спуск до BATCH_LANES запросов в ногу; лишние полосы повторяют
+    // последний запрос
+    void find_lanes(const value_type* keys, size_type count, const_iterator* out) const {
+        value_type query[BATCH_LANES];
+        value_type next_keys[BATCH_LANES];
+        const Node* current[BATCH_LANES];
+        for (size_type l = 0; l < BATCH_LANES; ++l) {
+            query[l] = keys[std::min(l, count - 1)];
+            current[l] = head_.get();
+        }
 
         for (int i = max_level_; i >= 0; --i) {
-            while (current->forward[i] && !comp_(key, current->forward[i]->value)) {
-                current = current->forward[i];
+            while (true) {
+                for (size_type l = 0; l < BATCH_LANES; ++l) {
+                    const Node* next = current[l]->forward[i].get();
+                    next_keys[l] = next ? next->value : query[l];
+                }
+                unsigned mask = detail::lanes_less(next_keys, query);
+                if (mask == 0) {
+                    break;
+                }
+                for (size_type l = 0; l < BATCH_LANES; ++l) {
+                    if (mask & (1u << l)) {
+                        current[l] = current[l]->forward[i].get();
+                    }
+                }
             }
         }
 
-        return iterator(current->forward[0]);
+        for (size_type l = 0; l < count; ++l) {
+            const NodePtr& candidate = current[l]->forward[0];
+            out[l] = candidate && candidate->value == query[l] ? const_iterator(candidate)
+                                                                : const_iterator();
+        }
+    }
+
+    iterator find_impl(const value_type& key) const {
+        const NodePtr& candidate = bound_link(key, false);
+        if (candidate && !comp_(key, candidate->value)) {
+            return iterator(candidate);
+        }
+
+        return iterator(nullptr);
+    }
+
+    iterator lower_bound_impl(const value_type& key) const {
+        return iterator(bound_link(key, false));
+    }
+
+    iterator upper_bound_impl(const value_type& key) const {
+        return iterator(upper_bound_node(key));
     }
 };
 
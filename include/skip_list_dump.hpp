@@ -0,0 +1,236 @@
+/**
+ * @file skip_list_dump.hpp
+ * @brief Согласованный дамп skip_list в файл без остановки записи
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef SKIP_LIST_DUMP_HPP
+#define SKIP_LIST_DUMP_HPP
+
+#include "dump_file.hpp"
+#include "skip_list.hpp"
+
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+/**
+ * @brief Дамп списка в файл path на момент создания
+ *
+ * Значения копируются в блоки порциями: по PIGGYBACK при каждой вставке
+ * и удалении в списке и по limit при вызовах step(), которые владелец
+ * может выполнять в моменты простоя. Кодирование блоков Codec и запись
+ * в файл выполняет фоновый поток, поэтому вставка и удаление не ждут
+ * диска.
+ *
+ * Дамп согласован на момент создания: ключи, вставленные после него,
+ * пропускаются, а удаленные узлы, еще не попавшие в дамп, удерживаются
+ * до записи. Изменение значений через итератор во время дампа не
+ * отслеживается. Если список очищается, разрушается или заменяется
+ * присваиванием, недописанный остаток снимка дочитывается из снятой
+ * цепочки узлов. Файл появляется под именем path только после finish();
+ * прочитать его можно функцией read_dump<Codec>().
+ *
+ * Деструктор доводит дамп до конца сам: проходит оставшуюся часть снимка
+ * и ждет записи файла с fdatasync. Чтобы не блокироваться в нем,
+ * вызовите finish() заранее.
+ */
+template<typename List, typename Codec = raw_codec<typename List::value_type>>
+class skip_list_dump : public skip_list_observer<List> {
+    using value_type = typename List::value_type;
+    using value_compare = typename List::value_compare;
+    using node_ptr = decltype(std::declval<typename List::iterator>().get_node());
+
+    struct node_value_less {
+        value_compare comp;
+
+        bool operator()(const node_ptr& a, const node_ptr& b) const {
+            return comp(a->value, b->value);
+        }
+    };
+
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type BATCH = 1024;
+    static constexpr size_type PIGGYBACK = 32;
+
+    /// @throws std::runtime_error если файл не открывается
+    skip_list_dump(List& list, const std::string& path)
+        : writer_(path), comp_(list.value_comp()), inserted_(comp_),
+          erased_(node_value_less{comp_}) {
+        static_assert(std::is_copy_constructible_v<value_type>, "Dump stores copies of values");
+        list.add_observer(this);
+    }
+
+    skip_list_dump(const skip_list_dump&) = delete;
+    skip_list_dump& operator=(const skip_list_dump&) = delete;
+
+    ~skip_list_dump() {
+        try {
+            finish();
+        } catch (...) {
+            detach();
+        }
+        // Узлы отпускаются по возрастанию и итеративно, без каскада
+        // рекурсивных деструкторов по длинным цепочкам
+        while (!erased_.empty()) {
+            erased_.erase(erased_.begin());
+        }
+        release(std::move(detached_));
+    }
+
+    /// true до завершения finish()
+    bool active() const noexcept {
+        return !finished_;
+    }
+
+    /**
+     * @brief Передает на запись не более limit значений дампа
+     * @return Число переданных значений; 0 - снимок пройден целиком
+     */
+    size_type step(size_type limit) {
+        if (walked_) {
+            return 0;
+        }
+        node_ptr node = cut_ ? detached_ : remainder();
+        std::vector<value_type> batch;
+        while (batch.size() < limit) {
+            while (node && !inserted_.empty()) {
+                auto it = inserted_.find(node->value);
+                if (it == inserted_.end()) {
+                    break;
+                }
+                inserted_.erase(it);
+                node = node->forward[0];
+            }
+            auto erased = erased_.begin();
+            if (!node && erased == erased_.end()) {
+                walked_ = true;
+                break;
+            }
+            if (!node || (erased != erased_.end() && comp_((*erased)->value, node->value))) {
+                batch.push_back((*erased)->value);
+                erased_.erase(erased);
+            } else {
+                batch.push_back(node->value);
+                node = node->forward[0];
+            }
+        }
+
+        size_type count = batch.size();
+        if (!batch.empty()) {
+            cursor_ = batch.back();
+            writer_.template push_values<Codec>(std::move(batch));
+        }
+        if (cut_) {
+            // Пройденная часть снятой цепочки освобождается итеративно
+            node_ptr passed = std::exchange(detached_, std::move(node));
+            release(std::move(passed));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Дописывает дамп, ждет фоновую запись и публикует файл
+     * @throws std::runtime_error при ошибке записи; файл не публикуется
+     */
+    void finish() {
+        if (finished_) {
+            return;
+        }
+        while (step(BATCH) != 0) {
+        }
+        detach();
+        finished_ = true;
+        writer_.finish();
+    }
+
+    void on_attach(List& list) override {
+        list_ = &list;
+    }
+
+    void on_insert(typename List::iterator inserted) override {
+        if (!walked_ && !cut_ && (!cursor_ || comp_(*cursor_, *inserted))) {
+            inserted_.insert(*inserted);
+        }
+        step(PIGGYBACK);
+    }
+
+    void on_erase(typename List::iterator erased) override {
+        if (!walked_ && !cut_ && (!cursor_ || comp_(*cursor_, *erased))) {
+            auto it = inserted_.find(*erased);
+            if (it != inserted_.end()) {
+                inserted_.erase(it);
+            } else {
+                erased_.insert(erased.get_node());
+            }
+        }
+        step(PIGGYBACK);
+    }
+
+    void on_clear() noexcept override {
+        cut();
+    }
+
+    void on_detach() noexcept override {
+        cut();
+        list_ = nullptr;
+    }
+
+private:
+    // Первый узел списка за курсором
+    node_ptr remainder() const {
+        return cursor_ ? list_->upper_bound(*cursor_).get_node() : list_->begin().get_node();
+    }
+
+    // Недописанный остаток снимка дочитывается из снятой цепочки
+    void cut() noexcept {
+        if (!walked_ && !cut_) {
+            detached_ = remainder();
+            cut_ = true;
+        }
+    }
+
+    void detach() noexcept {
+        if (list_) {
+            list_->remove_observer(this);
+        }
+    }
+
+    static void release(node_ptr chain) noexcept {
+        if (!chain) {
+            return;
+        }
+        try {
+            std::vector<node_ptr> work;
+            work.push_back(std::move(chain));
+            detail::release_chains(work, static_cast<size_t>(-1));
+        } catch (const std::bad_alloc&) {
+        }
+    }
+
+    detail::dump_writer writer_;
+    value_compare comp_;
+    List* list_ = nullptr;
+    std::optional<value_type> cursor_;         ///< последний записанный ключ
+    std::set<value_type, value_compare> inserted_; ///< вставлены за курсором после начала
+    std::set<node_ptr, node_value_less> erased_;   ///< удалены за курсором после начала
+    node_ptr detached_;                        ///< следующий узел цепочки, снятой со списка
+    bool cut_ = false;
+    bool walked_ = false;
+    bool finished_ = false;
+};
+
+} // namespace stl
+
+#endif // SKIP_LIST_DUMP_HPP
@@ -0,0 +1,230 @@
+/**
+ * @file sort_key_skip_list.hpp
+ * @brief Список с пропусками, сравнивающий заранее вычисленные ключи сортировки
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef SORT_KEY_SKIP_LIST_HPP
+#define SORT_KEY_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <locale>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace stl {
+
+/**
+ * @brief Ключ сортировки по правилам сопоставления локали
+ *
+ * std::collate::transform строит строку, побайтовое сравнение которой
+ * совпадает с collate::compare, поэтому дорогое сопоставление выполняется
+ * один раз на элемент.
+ */
+class collate_sort_key {
+public:
+    explicit collate_sort_key(const std::locale& locale = std::locale())
+        : locale_(locale), collate_(&std::use_facet<std::collate<char>>(locale_)) {}
+
+    std::string operator()(const std::string& value) const {
+        return collate_->transform(value.data(), value.data() + value.size());
+    }
+
+private:
+    std::locale locale_;
+    const std::collate<char>* collate_;
+};
+
+namespace detail {
+
+template<typename T>
+struct sort_key_entry {
+    std::string key;
+    T value;
+};
+
+// Побайтовое сравнение ключей как беззнаковых байтов
+struct sort_key_less {
+    template<typename T>
+    bool operator()(const sort_key_entry<T>& a, const sort_key_entry<T>& b) const noexcept {
+        size_t common = std::min(a.key.size(), b.key.size());
+        int order = std::memcmp(a.key.data(), b.key.data(), common);
+        return order != 0 ? order < 0 : a.key.size() < b.key.size();
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Упорядоченное множество с дорогим сравнением через ключи сортировки
+ *
+ * SortKey - функциональный объект std::string(const T&), чей результат при
+ * побайтовом сравнении задает нужный порядок. Ключ вычисляется один раз при
+ * вставке и хранится в узле рядом со значением, а для поиска - один раз на
+ * искомое значение; спуск по списку сравнивает ключи через memcmp.
+ * Элементы с равными ключами считаются равными.
+ */
+template<typename T, typename SortKey = collate_sort_key>
+class sort_key_skip_list {
+    static_assert(std::is_default_constructible_v<T>,
+                  "T must be default constructible to build lookup probes");
+
+    using entry = detail::sort_key_entry<T>;
+    using list_type = skip_list<entry, detail::sort_key_less>;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using sort_key_type = SortKey;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        explicit const_iterator(typename list_type::const_iterator it) : it_(it) {}
+
+        reference operator*() const {
+            return it_->value;
+        }
+
+        pointer operator->() const {
+            return &it_->value;
+        }
+
+        /// Ключ сортировки текущего элемента
+        const std::string& sort_key() const {
+            return it_->key;
+        }
+
+        const_iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++it_;
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return it_ == other.it_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        typename list_type::const_iterator it_;
+    };
+
+    using iterator = const_iterator;
+
+private:
+    list_type list_;
+    sort_key_type sort_key_;
+
+public:
+    sort_key_skip_list() = default;
+
+    explicit sort_key_skip_list(const SortKey& sort_key) : sort_key_(sort_key) {}
+
+    sort_key_skip_list(std::initializer_list<value_type> init, const SortKey& sort_key = SortKey())
+        : sort_key_(sort_key) {
+        for (const auto& value : init) {
+            insert(value);
+        }
+    }
+
+    // Итераторы
+    const_iterator begin() const {
+        return const_iterator(list_.begin());
+    }
+
+    const_iterator end() const {
+        return const_iterator(list_.end());
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return list_.empty();
+    }
+
+    size_type size() const noexcept {
+        return list_.size();
+    }
+
+    // Модификаторы
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert(value_type(value));
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        std::string key = sort_key_(value);
+        auto [it, inserted] = list_.insert(entry{std::move(key), std::move(value)});
+        return {const_iterator(typename list_type::const_iterator(it.get_node())), inserted};
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    size_type erase(const value_type& key) {
+        return list_.erase(probe(key));
+    }
+
+    void clear() noexcept {
+        list_.clear();
+    }
+
+    // Поиск
+    const_iterator find(const value_type& key) const {
+        return const_iterator(list_.find(probe(key)));
+    }
+
+    size_type count(const value_type& key) const {
+        return list_.count(probe(key));
+    }
+
+    bool contains(const value_type& key) const {
+        return count(key) != 0;
+    }
+
+    const_iterator lower_bound(const value_type& key) const {
+        return const_iterator(list_.lower_bound(probe(key)));
+    }
+
+    const_iterator upper_bound(const value_type& key) const {
+        return const_iterator(list_.upper_bound(probe(key)));
+    }
+
+    // Наблюдатели
+    const sort_key_type& sort_key() const noexcept {
+        return sort_key_;
+    }
+
+private:
+    entry probe(const value_type& key) const {
+        return entry{sort_key_(key), value_type{}};
+    }
+};
+
+} // namespace stl
+
+#endif // SORT_KEY_SKIP_LIST_HPP
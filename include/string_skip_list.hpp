@@ -0,0 +1,422 @@
+/**
+ * @file string_skip_list.hpp
+ * @brief Список с пропусками для строк: байты ключей и узлы в арене контейнера
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef STRING_SKIP_LIST_HPP
+#define STRING_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+namespace detail {
+
+/**
+ * @brief Арена только для добавления: память выделяется блоками и
+ * освобождается целиком
+ */
+class byte_arena {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        size_t offset = (used_ + align - 1) & ~(align - 1);
+        if (blocks_.empty() || offset + bytes > capacity_) {
+            capacity_ = std::max(BLOCK_SIZE, bytes + align);
+            blocks_.push_back(std::make_unique<char[]>(capacity_));
+            reserved_ += capacity_;
+            offset = 0;
+        }
+        char* block = blocks_.back().get();
+        // Начало блока из new[] выровнено по max_align_t
+        used_ = offset + bytes;
+        return block + offset;
+    }
+
+    std::string_view copy(std::string_view bytes) {
+        if (bytes.empty()) {
+            return {};
+        }
+        auto* out = static_cast<char*>(allocate(bytes.size(), 1));
+        std::memcpy(out, bytes.data(), bytes.size());
+        return {out, bytes.size()};
+    }
+
+    /// Байт, зарезервированных блоками
+    size_t reserved() const noexcept {
+        return reserved_;
+    }
+
+    void release() noexcept {
+        blocks_.clear();
+        capacity_ = 0;
+        used_ = 0;
+        reserved_ = 0;
+    }
+
+    void swap(byte_arena& other) noexcept {
+        blocks_.swap(other.blocks_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(used_, other.used_);
+        std::swap(reserved_, other.reserved_);
+    }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief Упорядоченное множество строк с ключами в арене
+ *
+ * Байты ключей копируются в арену контейнера, а узел хранит string_view на
+ * них и первые восемь байт ключа в виде числа, поэтому большинство
+ * сравнений при спуске не читает байты из арены. Узлы переменной высоты
+ * выделяются из отдельной арены: вставка не вызывает выделений памяти на
+ * ключ, а уничтожение списка освобождает несколько крупных блоков.
+ *
+ * Узлы удаленных ключей переиспользуются вставками той же высоты, байты
+ * их ключей остаются в арене до compact().
+ */
+class string_skip_list {
+    struct node {
+        std::string_view key;
+        uint64_t prefix;
+        size_t height;
+
+        // Ссылки вперед размещаются сразу за узлом
+        node** next() noexcept {
+            return reinterpret_cast<node**>(this + 1);
+        }
+
+        node* const* next() const noexcept {
+            return reinterpret_cast<node* const*>(this + 1);
+        }
+    };
+
+public:
+    using value_type = std::string_view;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        const_iterator() = default;
+        explicit const_iterator(const node* n) : current_(n) {}
+
+        reference operator*() const {
+            if (!current_) {
+                throw std::runtime_error("Dereferencing null iterator");
+            }
+            return current_->key;
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (current_) {
+                current_ = current_->next()[0];
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return current_ == other.current_;
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const node* current_ = nullptr;
+    };
+
+    using iterator = const_iterator;
+
+private:
+    detail::byte_arena keys_;
+    detail::byte_arena nodes_;
+    std::unique_ptr<char[]> head_storage_;
+    node* head_ = nullptr;
+    size_type size_ = 0;
+    size_t max_height_ = 1;
+    size_t live_bytes_ = 0;
+    size_t dead_bytes_ = 0;
+    std::array<std::vector<node*>, MAX_LEVEL> free_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+
+public:
+    string_skip_list()
+        : head_storage_(std::make_unique<char[]>(node_bytes(MAX_LEVEL))),
+          head_(construct_node(head_storage_.get(), MAX_LEVEL)),
+          gen_(std::random_device{}()), dist_(0.0, 1.0) {}
+
+    string_skip_list(std::initializer_list<std::string_view> init) : string_skip_list() {
+        for (auto key : init) {
+            insert(key);
+        }
+    }
+
+    string_skip_list(const string_skip_list&) = delete;
+    string_skip_list& operator=(const string_skip_list&) = delete;
+
+    // Итераторы
+    const_iterator begin() const noexcept {
+        return const_iterator(head_->next()[0]);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    /// Байт ключей, принадлежащих элементам списка
+    size_t live_key_bytes() const noexcept {
+        return live_bytes_;
+    }
+
+    /// Байт ключей удаленных элементов, которые вернет compact()
+    size_t dead_key_bytes() const noexcept {
+        return dead_bytes_;
+    }
+
+    /// Байт, зарезервированных аренами ключей и узлов
+    size_t arena_bytes() const noexcept {
+        return keys_.reserved() + nodes_.reserved();
+    }
+
+    // Модификаторы
+    std::pair<iterator, bool> insert(std::string_view key) {
+        uint64_t prefix = make_prefix(key);
+        std::array<node*, MAX_LEVEL> update;
+        node* candidate = predecessors(key, prefix, update);
+        if (candidate && compare(candidate, key, prefix) == 0) {
+            return {iterator(candidate), false};
+        }
+
+        size_t height = random_height();
+        for (size_t i = max_height_; i < height; ++i) {
+            update[i] = head_;
+        }
+        max_height_ = std::max(max_height_, height);
+
+        std::string_view stored = keys_.copy(key);
+        node* fresh = acquire_node(height);
+        fresh->key = stored;
+        fresh->prefix = prefix;
+        for (size_t i = 0; i < height; ++i) {
+            fresh->next()[i] = update[i]->next()[i];
+            update[i]->next()[i] = fresh;
+        }
+        live_bytes_ += key.size();
+        ++size_;
+        return {iterator(fresh), true};
+    }
+
+    size_type erase(std::string_view key) {
+        uint64_t prefix = make_prefix(key);
+        std::array<node*, MAX_LEVEL> update;
+        node* target = predecessors(key, prefix, update);
+        if (!target || compare(target, key, prefix) != 0) {
+            return 0;
+        }
+
+        for (size_t i = 0; i < target->height; ++i) {
+            update[i]->next()[i] = target->next()[i];
+        }
+        while (max_height_ > 1 && !head_->next()[max_height_ - 1]) {
+            --max_height_;
+        }
+        live_bytes_ -= target->key.size();
+        dead_bytes_ += target->key.size();
+        free_[target->height - 1].push_back(target);
+        --size_;
+        return 1;
+    }
+
+    /// Освобождает арены ключей и узлов целиком
+    void clear() noexcept {
+        keys_.release();
+        nodes_.release();
+        for (auto& list : free_) {
+            list.clear();
+        }
+        size_ = 0;
+        max_height_ = 1;
+        live_bytes_ = 0;
+        dead_bytes_ = 0;
+        std::fill_n(head_->next(), MAX_LEVEL, nullptr);
+    }
+
+    /**
+     * @brief Копирует байты живых ключей в новую арену в порядке ключей
+     *
+     * Узлы и итераторы остаются действительными, но string_view,
+     * полученные до вызова, указывают в освобожденную память. Узлы
+     * переключаются на новую арену только после того, как скопированы
+     * все ключи, поэтому при исключении список остается прежним.
+     */
+    void compact() {
+        detail::byte_arena fresh;
+        std::vector<std::string_view> keys;
+        keys.reserve(size_);
+        for (node* n = head_->next()[0]; n; n = n->next()[0]) {
+            keys.push_back(fresh.copy(n->key));
+        }
+
+        auto key = keys.begin();
+        for (node* n = head_->next()[0]; n; n = n->next()[0]) {
+            n->key = *key++;
+        }
+        keys_.swap(fresh);
+        dead_bytes_ = 0;
+    }
+
+    // Поиск
+    const_iterator find(std::string_view key) const {
+        uint64_t prefix = make_prefix(key);
+        const node* candidate = lower_bound_node(key, prefix);
+        return candidate && compare(candidate, key, prefix) == 0 ? const_iterator(candidate)
+                                                                 : end();
+    }
+
+    bool contains(std::string_view key) const {
+        return find(key) != end();
+    }
+
+    size_type count(std::string_view key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    const_iterator lower_bound(std::string_view key) const {
+        return const_iterator(lower_bound_node(key, make_prefix(key)));
+    }
+
+    const_iterator upper_bound(std::string_view key) const {
+        const_iterator it = lower_bound(key);
+        return it != end() && *it == key ? std::next(it) : it;
+    }
+
+private:
+    // Первые восемь байт в порядке старшинства: сравнение чисел совпадает
+    // с побайтовым сравнением строк, дополненных нулями
+    static uint64_t make_prefix(std::string_view key) noexcept {
+        uint64_t prefix = 0;
+        size_t n = std::min<size_t>(key.size(), 8);
+        for (size_t i = 0; i < 8; ++i) {
+            prefix <<= 8;
+            if (i < n) {
+                prefix |= static_cast<unsigned char>(key[i]);
+            }
+        }
+        return prefix;
+    }
+
+    static int compare(const node* n, std::string_view key, uint64_t prefix) noexcept {
+        if (n->prefix != prefix) {
+            return n->prefix < prefix ? -1 : 1;
+        }
+        return n->key.compare(key);
+    }
+
+    size_t random_height() {
+        size_t height = 1;
+        while (dist_(gen_) < P && height < MAX_LEVEL) {
+            ++height;
+        }
+        return height;
+    }
+
+    static size_t node_bytes(size_t height) noexcept {
+        return sizeof(node) + height * sizeof(node*);
+    }
+
+    static node* construct_node(void* memory, size_t height) noexcept {
+        auto* n = new (memory) node{{}, 0, height};
+        std::fill_n(n->next(), height, nullptr);
+        return n;
+    }
+
+    node* acquire_node(size_t height) {
+        auto& list = free_[height - 1];
+        if (list.empty()) {
+            return construct_node(nodes_.allocate(node_bytes(height), alignof(node)), height);
+        }
+        node* n = list.back();
+        list.pop_back();
+        return n;
+    }
+
+    node* predecessors(std::string_view key, uint64_t prefix,
+                       std::array<node*, MAX_LEVEL>& update) {
+        node* current = head_;
+        for (size_t i = max_height_; i-- > 0;) {
+            while (current->next()[i] && compare(current->next()[i], key, prefix) < 0) {
+                current = current->next()[i];
+            }
+            update[i] = current;
+        }
+        return current->next()[0];
+    }
+
+    const node* lower_bound_node(std::string_view key, uint64_t prefix) const {
+        const node* current = head_;
+        for (size_t i = max_height_; i-- > 0;) {
+            while (current->next()[i] && compare(current->next()[i], key, prefix) < 0) {
+                current = current->next()[i];
+            }
+        }
+        return current->next()[0];
+    }
+};
+
+} // namespace stl
+
+#endif // STRING_SKIP_LIST_HPP
@@ -0,0 +1,576 @@
+/**
+ * @file swmr_skip_list.hpp
+ * @brief Список с пропусками с одним писателем и неблокирующими читателями
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef SWMR_SKIP_LIST_HPP
+#define SWMR_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+#include "concurrency_stats.hpp"
+#include "epoch_reclaimer.hpp"
+#include "node_version.hpp"
+#include "write_batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+template<typename T>
+struct SwmrNode {
+    T value;
+    std::vector<std::atomic<SwmrNode*>> forward;
+    size_t level;
+    detail::node_version version;
+    // Номера пакетов, в которых узел появился и исчез (см. apply_batch)
+    std::atomic<uint64_t> born{0};
+    std::atomic<uint64_t> died{std::numeric_limits<uint64_t>::max()};
+
+    explicit SwmrNode(const T& val, size_t lvl = 0)
+        : value(val), forward(lvl + 1), level(lvl) {}
+
+    explicit SwmrNode(T&& val, size_t lvl = 0)
+        : value(std::move(val)), forward(lvl + 1), level(lvl) {}
+
+    /// Виден ли узел читателю, прочитавшему номер опубликованного пакета seq
+    bool visible_at(uint64_t seq) const noexcept {
+        return born.load(std::memory_order_relaxed) <= seq &&
+               seq < died.load(std::memory_order_relaxed);
+    }
+
+    static SwmrNode* skip_invisible(SwmrNode* node, uint64_t seq) {
+        while (node && !node->visible_at(seq)) {
+            node = node->forward[0].load(std::memory_order_acquire);
+        }
+        return node;
+    }
+};
+
+/**
+ * @brief Итератор чтения swmr_skip_list
+ *
+ * Удерживает закрепление эпохи, поэтому узел, на который он указывает,
+ * не освобождается, даже если писатель его удалил. Не должен передаваться
+ * между потоками.
+ */
+template<typename T>
+class SwmrIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+private:
+    using Node = SwmrNode<T>;
+
+    Node* current_ = nullptr;
+    uint64_t snapshot_ = 0;
+    epoch_reclaimer::guard guard_;
+
+public:
+    SwmrIterator() = default;
+    SwmrIterator(Node* node, uint64_t snapshot, epoch_reclaimer::guard guard)
+        : current_(node), snapshot_(snapshot), guard_(std::move(guard)) {}
+
+    reference operator*() const {
+        if (!current_) {
+            throw std::runtime_error("Dereferencing null iterator");
+        }
+        return current_->value;
+    }
+
+    pointer operator->() const {
+        if (!current_) {
+            throw std::runtime_error("Accessing null iterator");
+        }
+        return &(current_->value);
+    }
+
+    SwmrIterator& operator++() {
+        if (current_) {
+            current_ = Node::skip_invisible(current_->forward[0].load(std::memory_order_acquire),
+                                            snapshot_);
+        }
+        return *this;
+    }
+
+    SwmrIterator operator++(int) {
+        SwmrIterator temp = *this;
+        ++(*this);
+        return temp;
+    }
+
+    bool operator==(const SwmrIterator& other) const {
+        return current_ == other.current_;
+    }
+
+    bool operator!=(const SwmrIterator& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Список с пропусками для схемы "один писатель, много читателей"
+ *
+ * Модифицирующие методы (insert, emplace, erase, clear, reclaim) может
+ * вызывать только один поток одновременно. Методы чтения безопасны из любых
+ * потоков параллельно с писателем: они не берут блокировок и не пишут в общие
+ * данные, кроме собственного слота эпохи.
+ *
+ * Писатель публикует башню нового узла снизу вверх release-записями, поэтому
+ * читатель, увидевший узел на любом уровне, видит и его значение. Удаленные
+ * узлы освобождаются через epoch_reclaimer после ухода всех читателей.
+ *
+ * apply_batch() делает набор изменений видимым разом: узлы пакета помечаются
+ * его номером, и читатель, прочитавший номер опубликованного пакета до начала
+ * операции, пропускает еще не рожденные и уже умершие для него узлы.
+ */
+template<typename T, typename Compare = std::less<T>>
+class swmr_skip_list {
+    static_assert(std::is_default_constructible_v<Compare>,
+                  "Compare must be default constructible");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using value_compare = Compare;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = SwmrIterator<T>;
+    using const_iterator = SwmrIterator<T>;
+
+private:
+    using Node = SwmrNode<T>;
+
+    Node* head_;
+    std::atomic<size_type> size_;
+    std::atomic<size_type> max_level_;
+    std::atomic<uint64_t> published_;
+    value_compare comp_;
+    std::mt19937 gen_;
+    std::uniform_real_distribution<double> dist_;
+    mutable epoch_reclaimer reclaimer_;
+    mutable concurrency_stats stats_;
+
+public:
+    swmr_skip_list() : swmr_skip_list(Compare()) {}
+
+    explicit swmr_skip_list(const Compare& comp)
+        : head_(new Node(T{}, MAX_LEVEL)), size_(0), max_level_(0), published_(0), comp_(comp),
+          gen_(std::random_device{}()), dist_(0.0, 1.0) {}
+
+    swmr_skip_list(std::initializer_list<value_type> init, const Compare& comp = Compare())
+        : swmr_skip_list(comp) {
+        for (const auto& value : init) {
+            insert(value);
+        }
+    }
+
+    swmr_skip_list(const swmr_skip_list&) = delete;
+    swmr_skip_list& operator=(const swmr_skip_list&) = delete;
+
+    ~swmr_skip_list() {
+        Node* current = head_->forward[0].load(std::memory_order_relaxed);
+        while (current) {
+            Node* next = current->forward[0].load(std::memory_order_relaxed);
+            delete current;
+            current = next;
+        }
+        delete head_;
+    }
+
+    // Итераторы
+    const_iterator begin() const {
+        auto guard = reclaimer_.pin();
+        uint64_t snapshot = published_.load(std::memory_order_acquire);
+        Node* first = Node::skip_invisible(head_->forward[0].load(std::memory_order_acquire),
+                                           snapshot);
+        return const_iterator(first, snapshot, std::move(guard));
+    }
+
+    const_iterator cbegin() const {
+        return begin();
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    // Модификаторы (только поток-писатель)
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_impl(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_impl(std::move(value));
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    size_type erase(const value_type& key) {
+        std::vector<Node*> update(MAX_LEVEL, head_);
+        Node* target = find_predecessors(key, update);
+
+        if (!target || comp_(key, target->value)) {
+            return 0;
+        }
+
+        unlink_node(target, update);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return 1;
+    }
+
+    /**
+     * @brief Атомарно применяет пакет вставок и удалений
+     *
+     * Пакет сортируется, и все изменения вносятся за один проход по списку.
+     * Новые узлы связываются заранее, но остаются невидимыми; одна
+     * release-запись номера пакета открывает их и скрывает удаляемые узлы,
+     * после чего те отсоединяются. scan() и поиск по ключу видят либо весь
+     * пакет, либо ничего из него; обход итератором, как и прежде, не
+     * является снимком.
+     *
+     * @return Число фактически вставленных и удаленных элементов
+     */
+    size_type apply_batch(write_batch<value_type>&& batch) {
+        auto& operations = batch.normalize(comp_);
+        if (operations.empty()) {
+            return 0;
+        }
+
+        uint64_t seq = published_.load(std::memory_order_relaxed) + 1;
+        std::vector<Node*> update(MAX_LEVEL, head_);
+        std::vector<Node*> doomed;
+        size_type inserted = 0;
+
+        for (auto& operation : operations) {
+            Node* current = find_predecessors(operation.value, update);
+            bool found = current && !comp_(operation.value, current->value);
+
+            if (operation.op == write_batch<value_type>::op_type::insert) {
+                if (!found) {
+                    Node* node = link_node(std::move(operation.value), update, seq);
+                    for (size_type i = 0; i <= node->level; ++i) {
+                        update[i] = node;
+                    }
+                    ++inserted;
+                }
+            } else if (found) {
+                current->died.store(seq, std::memory_order_relaxed);
+                doomed.push_back(current);
+            }
+        }
+
+        published_.store(seq, std::memory_order_release);
+
+        std::fill(update.begin(), update.end(), head_);
+        for (Node* target : doomed) {
+            find_predecessors(target->value, update);
+            unlink_node(target, update);
+        }
+
+        size_.store(size_.load(std::memory_order_relaxed) + inserted - doomed.size(),
+                    std::memory_order_relaxed);
+        return inserted + doomed.size();
+    }
+
+    void clear() {
+        Node* current = head_->forward[0].load(std::memory_order_relaxed);
+        head_->version.begin_write();
+        for (Node* node = current; node; node = node->forward[0].load(std::memory_order_relaxed)) {
+            node->version.begin_write();
+        }
+        for (size_type i = MAX_LEVEL + 1; i-- > 0;) {
+            head_->forward[i].store(nullptr, std::memory_order_release);
+        }
+        max_level_.store(0, std::memory_order_release);
+        size_.store(0, std::memory_order_relaxed);
+        head_->version.end_write();
+
+        while (current) {
+            Node* next = current->forward[0].load(std::memory_order_relaxed);
+            reclaimer_.retire(current);
+            current = next;
+        }
+    }
+
+    /// Освобождает узлы, которые больше не видны ни одному читателю
+    size_type reclaim() {
+        return reclaimer_.reclaim();
+    }
+
+    /// Закрепляет эпоху на время серии чтений в текущем потоке
+    epoch_reclaimer::guard pin() const {
+        return reclaimer_.pin();
+    }
+
+    // Поиск (любой поток)
+    const_iterator find(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        uint64_t snapshot = published_.load(std::memory_order_acquire);
+        Node* current = lower_bound_node(key, snapshot);
+
+        if (current && !comp_(key, current->value)) {
+            return const_iterator(current, snapshot, std::move(guard));
+        }
+
+        return end();
+    }
+
+    bool contains(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        Node* current = lower_bound_node(key, published_.load(std::memory_order_acquire));
+        return current && !comp_(key, current->value);
+    }
+
+    size_type count(const value_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    const_iterator lower_bound(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        uint64_t snapshot = published_.load(std::memory_order_acquire);
+        Node* current = lower_bound_node(key, snapshot);
+        return current ? const_iterator(current, snapshot, std::move(guard)) : end();
+    }
+
+    const_iterator upper_bound(const value_type& key) const {
+        auto guard = reclaimer_.pin();
+        uint64_t snapshot = published_.load(std::memory_order_acquire);
+        Node* current = head_;
+
+        for (size_type i = max_level_.load(std::memory_order_acquire) + 1; i-- > 0;) {
+            Node* next = current->forward[i].load(std::memory_order_acquire);
+            while (next && !comp_(key, next->value)) {
+                current = next;
+                next = current->forward[i].load(std::memory_order_acquire);
+            }
+        }
+
+        Node* result = Node::skip_invisible(current->forward[0].load(std::memory_order_acquire),
+                                            snapshot);
+        return result ? const_iterator(result, snapshot, std::move(guard)) : end();
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const value_type& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    /**
+     * @brief Согласованная копия элементов из [lo, hi] без блокировки писателя
+     *
+     * Читает участок оптимистично, запоминая версии пройденных узлов, и
+     * повторяет чтение, если писатель успел изменить хотя бы один из них.
+     * Результат соответствует состоянию списка в момент проверки.
+     */
+    std::vector<value_type> scan(const value_type& lo, const value_type& hi) const {
+        std::vector<value_type> result;
+        std::vector<std::pair<const Node*, uint64_t>> versions;
+
+        while (!try_scan(lo, hi, result, versions)) {
+            stats_.scan_retry();
+        }
+        return result;
+    }
+
+    // Наблюдатели
+    value_compare value_comp() const {
+        return comp_;
+    }
+
+    /**
+     * @brief Счетчики конкуренции; читаются без остановки списка
+     *
+     * Писатель единственный и не выполняет CAS, поэтому содержательны
+     * повторы сканирования и очередь узлов, ожидающих освобождения.
+     */
+    concurrency_stats::snapshot stats() const {
+        auto result = stats_.read();
+        result.reclamation_backlog = reclaimer_.pending();
+        result.epoch = reclaimer_.epoch();
+        return result;
+    }
+
+private:
+    size_type random_level() {
+        size_type level = 0;
+        while (dist_(gen_) < P && level < MAX_LEVEL - 1) {
+            ++level;
+        }
+        return level;
+    }
+
+    bool try_scan(const value_type& lo, const value_type& hi, std::vector<value_type>& result,
+                  std::vector<std::pair<const Node*, uint64_t>>& versions) const {
+        auto guard = reclaimer_.pin();
+        uint64_t snapshot = published_.load(std::memory_order_acquire);
+        result.clear();
+        versions.clear();
+
+        const Node* current = predecessor_node(lo);
+        while (true) {
+            uint64_t version;
+            if (!current->version.read_stable(version)) {
+                return false;
+            }
+            versions.emplace_back(current, version);
+
+            const Node* next = current->forward[0].load(std::memory_order_acquire);
+            if (!next || comp_(hi, next->value)) {
+                break;
+            }
+            // Узлы меньше lo могли быть вставлены после спуска
+            if (!comp_(next->value, lo) && next->visible_at(snapshot)) {
+                result.push_back(next->value);
+            }
+            current = next;
+        }
+
+        for (const auto& [node, version] : versions) {
+            if (!node->version.validate(version)) {
+                return false;
+            }
+        }
+        // Пакет, опубликованный во время обхода, мог уже отсоединить узлы,
+        // видимые в прочитанном снимке
+        return published_.load(std::memory_order_acquire) == snapshot;
+    }
+
+    Node* predecessor_node(const value_type& key) const {
+        Node* current = head_;
+
+        for (size_type i = max_level_.load(std::memory_order_acquire) + 1; i-- > 0;) {
+            Node* next = current->forward[i].load(std::memory_order_acquire);
+            while (next && comp_(next->value, key)) {
+                current = next;
+                next = current->forward[i].load(std::memory_order_acquire);
+            }
+        }
+
+        return current;
+    }
+
+    Node* lower_bound_node(const value_type& key, uint64_t snapshot) const {
+        return Node::skip_invisible(predecessor_node(key)->forward[0].load(std::memory_order_acquire),
+                                    snapshot);
+    }
+
+    // Вызывается только писателем: ссылки меняет лишь он сам. update может
+    // содержать предшественников меньшего ключа - спуск тогда начинается с них
+    Node* find_predecessors(const value_type& key, std::vector<Node*>& update) const {
+        Node* current = head_;
+
+        for (size_type i = max_level_.load(std::memory_order_relaxed) + 1; i-- > 0;) {
+            if (update[i] != head_ && (current == head_ || comp_(current->value, update[i]->value))) {
+                current = update[i];
+            }
+            Node* next = current->forward[i].load(std::memory_order_relaxed);
+            while (next && comp_(next->value, key)) {
+                current = next;
+                next = current->forward[i].load(std::memory_order_relaxed);
+            }
+            update[i] = current;
+        }
+
+        return current->forward[0].load(std::memory_order_relaxed);
+    }
+
+    template<typename U>
+    std::pair<iterator, bool> insert_impl(U&& value) {
+        std::vector<Node*> update(MAX_LEVEL, head_);
+        Node* current = find_predecessors(value, update);
+
+        if (current && !comp_(value, current->value)) {
+            return {iterator(current, published_.load(std::memory_order_relaxed), reclaimer_.pin()),
+                    false};
+        }
+
+        Node* new_node = link_node(std::forward<U>(value), update, 0);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return {iterator(new_node, published_.load(std::memory_order_relaxed), reclaimer_.pin()),
+                true};
+    }
+
+    template<typename U>
+    Node* link_node(U&& value, const std::vector<Node*>& update, uint64_t born) {
+        size_type new_level = random_level();
+        Node* new_node = new Node(std::forward<U>(value), new_level);
+        new_node->born.store(born, std::memory_order_relaxed);
+
+        for (size_type i = 0; i <= new_level; ++i) {
+            new_node->forward[i].store(update[i]->forward[i].load(std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+        }
+
+        // Публикация снизу вверх: узел становится видимым на уровне 0 раньше,
+        // чем на верхних уровнях, и только после полной инициализации
+        update[0]->version.begin_write();
+        update[0]->forward[0].store(new_node, std::memory_order_release);
+        update[0]->version.end_write();
+        for (size_type i = 1; i <= new_level; ++i) {
+            update[i]->forward[i].store(new_node, std::memory_order_release);
+        }
+
+        if (new_level > max_level_.load(std::memory_order_relaxed)) {
+            max_level_.store(new_level, std::memory_order_release);
+        }
+        return new_node;
+    }
+
+    void unlink_node(Node* target, const std::vector<Node*>& update) {
+        // Отсоединение сверху вниз: читатель, стоящий на удаляемом узле,
+        // продолжает обход по его неизменным ссылкам. Версия удаляемого
+        // узла остается незавершенной, чтобы сканирование через него
+        // начиналось заново
+        update[0]->version.begin_write();
+        target->version.begin_write();
+        for (size_type i = target->level + 1; i-- > 0;) {
+            Node* next = target->forward[i].load(std::memory_order_relaxed);
+            update[i]->forward[i].store(next, std::memory_order_release);
+        }
+        update[0]->version.end_write();
+
+        size_type level = max_level_.load(std::memory_order_relaxed);
+        while (level > 0 && !head_->forward[level].load(std::memory_order_relaxed)) {
+            --level;
+        }
+        max_level_.store(level, std::memory_order_release);
+
+        reclaimer_.retire(target);
+    }
+};
+
+} // namespace stl
+
+#endif // SWMR_SKIP_LIST_HPP
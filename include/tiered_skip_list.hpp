@@ -0,0 +1,587 @@
+/**
+ * @file tiered_skip_list.hpp
+ * @brief Список с пропусками с бюджетом памяти и выгрузкой холодных диапазонов на диск
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef TIERED_SKIP_LIST_HPP
+#define TIERED_SKIP_LIST_HPP
+
+#include "codec.hpp"
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+/**
+ * @brief Параметры tiered_skip_list
+ */
+struct tiered_options {
+    std::string spill_dir;             ///< каталог файлов выгруженных диапазонов; пусто - без диска
+    size_t max_resident = 1 << 20;     ///< бюджет: элементов в памяти
+    size_t segment_size = 4096;        ///< целевое число элементов диапазона
+    bool compress = false;             ///< сначала сжимать холодные диапазоны в памяти
+    size_t max_compressed_bytes = 64 << 20;  ///< сверх этого сжатые блоки уходят на диск
+};
+
+/**
+ * @brief Упорядоченное множество, выгружающее холодные диапазоны ключей
+ *
+ * Ключи делятся на диапазоны по нижним границам. Диапазон в памяти - это
+ * skip_list; выгруженный диапазон оставляет в каталоге только свою границу
+ * и файл, записанный кодеком Codec (см. codec.hpp). Любое обращение к
+ * выгруженному диапазону загружает его обратно. Когда элементов в памяти
+ * больше max_resident, выгружаются диапазоны, к которым дольше всего не
+ * обращались. Неизмененный диапазон повторно не записывается.
+ *
+ * С compress вытесняемый диапазон сначала сжимается кодеком в блок в
+ * памяти (см. delta_varint_codec и lz_codec) и распаковывается при
+ * обращении; на диск уходят самые холодные блоки, когда их объем
+ * превышает max_compressed_bytes. Без spill_dir сжатые блоки остаются в
+ * памяти. Холодность определяют счетчики обращений, которые периодически
+ * делятся пополам, а при равенстве - давность обращения.
+ *
+ * Диапазон, выросший вдвое больше segment_size, делится пополам, пустой
+ * диапазон удаляется. Итератор закрепляет свой диапазон в памяти, пока
+ * стоит на нем, и загружает следующий при переходе; закрепленный диапазон
+ * не вытесняется. Итераторы действительны до вставки или удаления и не
+ * должны переживать список. for_each() обходит список, не меняя уровни
+ * диапазонов.
+ */
+template<typename T, typename Compare = std::less<T>, typename Codec = raw_codec<T>>
+class tiered_skip_list {
+    using list_type = skip_list<T, Compare>;
+
+    struct segment {
+        std::optional<T> fence;            ///< нижняя граница; нет у первого
+        std::unique_ptr<list_type> resident;
+        size_t count = 0;
+        uint64_t id = 0;
+        uint64_t last_access = 0;
+        uint64_t hits = 0;
+        std::string compressed;            ///< сжатый блок, если is_compressed
+        bool is_compressed = false;
+        bool on_disk = false;
+        bool dirty = false;                ///< данные в памяти новее файла
+        size_t pins = 0;                   ///< итераторов на диапазоне
+    };
+
+    static constexpr uint64_t DECAY_PERIOD = 4096;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using value_compare = Compare;
+
+    /**
+     * @brief Прямой итератор, закрепляющий текущий диапазон в памяти
+     *
+     * Переход на следующий диапазон загружает его, снимает закрепление с
+     * пройденного и соблюдает бюджет, так что обход не держит в памяти
+     * больше одного диапазона сверх max_resident.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const_iterator(const const_iterator& other)
+            : owner_(other.owner_), index_(other.index_), id_(other.id_),
+              pinned_(other.pinned_), it_(other.it_), end_(other.end_) {
+            if (pinned_) {
+                ++owner_->segments_[index_].pins;
+            }
+        }
+
+        const_iterator& operator=(const_iterator other) noexcept {
+            std::swap(owner_, other.owner_);
+            std::swap(index_, other.index_);
+            std::swap(id_, other.id_);
+            std::swap(pinned_, other.pinned_);
+            std::swap(it_, other.it_);
+            std::swap(end_, other.end_);
+            return *this;
+        }
+
+        ~const_iterator() {
+            release();
+        }
+
+        reference operator*() const {
+            return *it_;
+        }
+
+        pointer operator->() const {
+            return &*it_;
+        }
+
+        const_iterator& operator++() {
+            ++it_;
+            settle();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return pinned_ == other.pinned_ && (!pinned_ || it_ == other.it_);
+        }
+
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class tiered_skip_list;
+
+        const_iterator(tiered_skip_list* owner, size_t index) : owner_(owner), index_(index) {
+            enter();
+        }
+
+        // Закрепляет первый непустой диапазон, начиная с index_
+        void enter() {
+            while (index_ < owner_->segments_.size() && owner_->segments_[index_].count == 0) {
+                ++index_;
+            }
+            if (index_ == owner_->segments_.size()) {
+                return;
+            }
+            segment& s = owner_->segments_[index_];
+            ++s.pins;
+            pinned_ = true;
+            id_ = s.id;
+            const list_type& list = owner_->load(index_);
+            it_ = list.begin();
+            end_ = list.end();
+            owner_->enforce_budget(index_);
+        }
+
+        void settle() {
+            if (it_ != end_) {
+                return;
+            }
+            size_t next = index_ + 1;
+            release();
+            index_ = next;
+            enter();
+        }
+
+        // Снимает закрепление; после вставки или удаления диапазон мог
+        // сместиться или исчезнуть
+        void release() noexcept {
+            if (!pinned_) {
+                return;
+            }
+            pinned_ = false;
+            auto& segments = owner_->segments_;
+            if (index_ >= segments.size() || segments[index_].id != id_) {
+                auto it = std::find_if(segments.begin(), segments.end(),
+                                       [this](const segment& s) { return s.id == id_; });
+                if (it == segments.end()) {
+                    return;
+                }
+                index_ = static_cast<size_t>(it - segments.begin());
+            }
+            --segments[index_].pins;
+        }
+
+        tiered_skip_list* owner_ = nullptr;
+        size_t index_ = 0;
+        uint64_t id_ = 0;
+        bool pinned_ = false;
+        typename list_type::const_iterator it_;
+        typename list_type::const_iterator end_;
+    };
+
+    using iterator = const_iterator;
+
+    explicit tiered_skip_list(tiered_options options, const Compare& comp = Compare())
+        : options_(std::move(options)), comp_(comp) {
+        if (options_.segment_size == 0 || options_.max_resident == 0) {
+            throw std::out_of_range("Segment size and resident budget must be positive");
+        }
+        if (options_.spill_dir.empty() && !options_.compress) {
+            throw std::out_of_range("Cold ranges need a spill directory or compression");
+        }
+        if (!options_.spill_dir.empty()) {
+            std::filesystem::create_directories(options_.spill_dir);
+        }
+        segments_.push_back(make_segment(std::nullopt));
+    }
+
+    tiered_skip_list(const tiered_skip_list&) = delete;
+    tiered_skip_list& operator=(const tiered_skip_list&) = delete;
+
+    /// Удаляет файлы выгруженных диапазонов
+    ~tiered_skip_list() {
+        for (const auto& s : segments_) {
+            remove_file(s);
+        }
+    }
+
+    // Итераторы; начало загружает первый диапазон
+    const_iterator begin() {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() {
+        return const_iterator();
+    }
+
+    // Емкость
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    /// Элементов в загруженных диапазонах
+    size_type resident_elements() const noexcept {
+        return resident_;
+    }
+
+    size_type segment_count() const noexcept {
+        return segments_.size();
+    }
+
+    /// Число диапазонов, хранящихся только на диске
+    size_type spilled_segments() const noexcept {
+        return static_cast<size_type>(
+            std::count_if(segments_.begin(), segments_.end(), [](const segment& s) {
+                return !s.resident && !s.is_compressed;
+            }));
+    }
+
+    /// Число диапазонов, сжатых в памяти
+    size_type compressed_segments() const noexcept {
+        return static_cast<size_type>(std::count_if(
+            segments_.begin(), segments_.end(), [](const segment& s) { return s.is_compressed; }));
+    }
+
+    /// Объем сжатых блоков в памяти
+    size_t compressed_bytes() const noexcept {
+        return compressed_bytes_;
+    }
+
+    // Модификаторы
+    bool insert(const value_type& value) {
+        size_t i = locate(value);
+        list_type& list = fault_in(i);
+        bool inserted = list.insert(value).second;
+        if (inserted) {
+            segment& s = segments_[i];
+            ++s.count;
+            ++size_;
+            ++resident_;
+            s.dirty = true;
+            if (s.count > 2 * options_.segment_size) {
+                split(i);
+            }
+        }
+        enforce_budget(locate(value));
+        return inserted;
+    }
+
+    size_type erase(const value_type& key) {
+        size_t i = locate(key);
+        size_type erased = fault_in(i).erase(key);
+        if (erased) {
+            segment& s = segments_[i];
+            --s.count;
+            --size_;
+            --resident_;
+            s.dirty = true;
+            if (s.count == 0 && i > 0) {
+                remove_file(s);
+                segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(i));
+                return erased;
+            }
+        }
+        enforce_budget(i);
+        return erased;
+    }
+
+    // Поиск
+    bool contains(const value_type& key) {
+        size_t i = locate(key);
+        bool found = fault_in(i).count(key) != 0;
+        enforce_budget(i);
+        return found;
+    }
+
+    /// Наименьший элемент, не меньший key
+    std::optional<value_type> lower_bound(const value_type& key) {
+        for (size_t i = locate(key); i < segments_.size(); ++i) {
+            list_type& list = fault_in(i);
+            auto it = list.lower_bound(key);
+            if (it != list.end()) {
+                value_type result = *it;
+                enforce_budget(i);
+                return result;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Вызывает f(value) для всех элементов по возрастанию
+     *
+     * Диапазон, загруженный только ради обхода, сразу возвращается на свой
+     * уровень, так что обход не вытесняет горячие диапазоны и не меняет
+     * счетчики обращений.
+     */
+    template<typename F>
+    void for_each(F&& f) {
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            segment& s = segments_[i];
+            bool was_resident = static_cast<bool>(s.resident);
+            bool was_on_disk = !was_resident && !s.is_compressed;
+            uint64_t hits = s.hits;
+            uint64_t last_access = s.last_access;
+            for (const auto& value : std::as_const(load(i))) {
+                f(value);
+            }
+            if (!was_resident) {
+                evict(i, was_on_disk);
+                segments_[i].hits = hits;
+                segments_[i].last_access = last_access;
+            }
+        }
+    }
+
+    /// Вытесняет все загруженные диапазоны, кроме закрепленных итераторами
+    void spill_all() {
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            if (segments_[i].resident && segments_[i].pins == 0) {
+                evict(i);
+            }
+        }
+    }
+
+private:
+    segment make_segment(std::optional<T> fence) {
+        segment s;
+        s.fence = std::move(fence);
+        s.resident = std::make_unique<list_type>(comp_);
+        s.id = next_id_++;
+        s.last_access = ++clock_;
+        return s;
+    }
+
+    // Диапазон, которому принадлежит key: последний с границей не больше key
+    size_t locate(const value_type& key) const {
+        auto it = std::upper_bound(segments_.begin() + 1, segments_.end(), key,
+                                   [this](const T& k, const segment& s) {
+                                       return comp_(k, *s.fence);
+                                   });
+        return static_cast<size_t>(it - segments_.begin()) - 1;
+    }
+
+    std::filesystem::path file_path(const segment& s) const {
+        return std::filesystem::path(options_.spill_dir) /
+               ("segment-" + std::to_string(s.id) + ".seg");
+    }
+
+    // Загружает диапазон i и учитывает обращение к нему
+    list_type& fault_in(size_t i) {
+        segment& s = segments_[i];
+        s.last_access = ++clock_;
+        ++s.hits;
+        if (clock_ % DECAY_PERIOD == 0) {
+            for (auto& other : segments_) {
+                other.hits /= 2;
+            }
+        }
+        return load(i);
+    }
+
+    list_type& load(size_t i) {
+        segment& s = segments_[i];
+        if (s.resident) {
+            return *s.resident;
+        }
+
+        std::vector<T> values;
+        if (s.is_compressed) {
+            values = Codec::decode(s.compressed);
+        } else {
+            std::ifstream in(file_path(s), std::ios::binary);
+            std::string bytes((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+            if (!in.good() && !in.eof()) {
+                throw std::runtime_error("Cannot read spilled segment " + file_path(s).string());
+            }
+            values = Codec::decode(bytes);
+        }
+        if (values.size() != s.count) {
+            throw std::runtime_error("Corrupted segment " + std::to_string(s.id));
+        }
+
+        auto list = std::make_unique<list_type>(comp_);
+        for (auto& value : values) {
+            list->insert(std::move(value));
+        }
+        s.resident = std::move(list);
+        if (s.is_compressed) {
+            compressed_bytes_ -= s.compressed.size();
+            std::string().swap(s.compressed);
+            s.is_compressed = false;
+        }
+        resident_ += s.count;
+        return *s.resident;
+    }
+
+    // Сжимает диапазон в памяти или, при to_disk либо без сжатия,
+    // записывает его на диск
+    void evict(size_t i, bool to_disk = false) {
+        segment& s = segments_[i];
+        to_disk = (to_disk || !options_.compress) && !options_.spill_dir.empty();
+        if (to_disk && !s.dirty && s.on_disk) {
+            s.resident.reset();
+            resident_ -= s.count;
+            return;
+        }
+
+        std::string bytes = Codec::encode(std::vector<T>(s.resident->begin(), s.resident->end()));
+        if (to_disk) {
+            write_file(s, bytes);
+        } else {
+            compressed_bytes_ += bytes.size();
+            s.compressed = std::move(bytes);
+            s.is_compressed = true;
+        }
+        s.resident.reset();
+        resident_ -= s.count;
+        if (!to_disk) {
+            enforce_compressed_budget();
+        }
+    }
+
+    void write_file(segment& s, const std::string& bytes) {
+        std::ofstream out(file_path(s), std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out) {
+            throw std::runtime_error("Cannot write spilled segment " + file_path(s).string());
+        }
+        s.on_disk = true;
+        s.dirty = false;
+    }
+
+    // Диапазон с наименьшим числом обращений среди подходящих, кроме keep
+    template<typename Eligible>
+    size_t coldest(size_t keep, Eligible eligible) const {
+        size_t victim = segments_.size();
+        for (size_t i = 0; i < segments_.size(); ++i) {
+            if (i == keep || !eligible(segments_[i])) {
+                continue;
+            }
+            if (victim == segments_.size() || segments_[i].hits < segments_[victim].hits ||
+                (segments_[i].hits == segments_[victim].hits &&
+                 segments_[i].last_access < segments_[victim].last_access)) {
+                victim = i;
+            }
+        }
+        return victim;
+    }
+
+    // Вытесняет самые холодные незакрепленные диапазоны, кроме keep
+    void enforce_budget(size_t keep) {
+        while (resident_ > options_.max_resident) {
+            size_t victim = coldest(keep, [](const segment& s) {
+                return s.resident != nullptr && s.pins == 0;
+            });
+            if (victim == segments_.size()) {
+                return;
+            }
+            evict(victim);
+        }
+    }
+
+    // Переносит самые холодные сжатые блоки на диск
+    void enforce_compressed_budget() {
+        if (options_.spill_dir.empty()) {
+            return;
+        }
+        while (compressed_bytes_ > options_.max_compressed_bytes) {
+            size_t victim = coldest(segments_.size(),
+                                    [](const segment& s) { return s.is_compressed; });
+            if (victim == segments_.size()) {
+                return;
+            }
+            segment& s = segments_[victim];
+            if (s.dirty || !s.on_disk) {
+                write_file(s, s.compressed);
+            }
+            compressed_bytes_ -= s.compressed.size();
+            std::string().swap(s.compressed);
+            s.is_compressed = false;
+        }
+    }
+
+    // Переносит верхнюю половину диапазона в новый диапазон за ним
+    void split(size_t i) {
+        std::vector<T> values(segments_[i].resident->begin(), segments_[i].resident->end());
+        size_t half = values.size() / 2;
+
+        segment upper = make_segment(values[half]);
+        auto lower = std::make_unique<list_type>(comp_);
+        for (size_t k = 0; k < values.size(); ++k) {
+            (k < half ? *lower : *upper.resident).insert(std::move(values[k]));
+        }
+        upper.count = values.size() - half;
+        upper.dirty = true;
+
+        segment& s = segments_[i];
+        s.resident = std::move(lower);
+        s.count = half;
+        s.dirty = true;
+        segments_.insert(segments_.begin() + static_cast<std::ptrdiff_t>(i) + 1,
+                         std::move(upper));
+    }
+
+    void remove_file(const segment& s) const noexcept {
+        if (s.on_disk) {
+            std::error_code ignored;
+            std::filesystem::remove(file_path(s), ignored);
+        }
+    }
+
+    tiered_options options_;
+    value_compare comp_;
+    std::vector<segment> segments_;
+    size_type size_ = 0;
+    size_type resident_ = 0;
+    size_t compressed_bytes_ = 0;
+    uint64_t clock_ = 0;
+    uint64_t next_id_ = 0;
+};
+
+} // namespace stl
+
+#endif // TIERED_SKIP_LIST_HPP
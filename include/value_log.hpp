@@ -0,0 +1,172 @@
+/**
+ * @file value_log.hpp
+ * @brief Журнал значений на диске с доступом по смещению
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef VALUE_LOG_HPP
+#define VALUE_LOG_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace stl {
+
+/**
+ * @brief Положение значения в журнале
+ */
+struct value_locator {
+    uint64_t offset = 0;
+    uint32_t length = 0;
+};
+
+/**
+ * @brief Файл, в конец которого дописываются значения
+ *
+ * Значения читаются через pread по value_locator, поэтому в памяти
+ * остается только индекс. Журнал - рабочий файл процесса: при открытии
+ * он обрезается, восстановление после сбоя не предусмотрено. Освобожденные
+ * значения лишь учитываются в dead_bytes(); место возвращает перезапись
+ * живых значений в новый журнал (см. kv_separated_map::collect_garbage).
+ */
+class value_log {
+public:
+    explicit value_log(std::string path) : path_(std::move(path)) {
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw_errno("Cannot open value log");
+        }
+    }
+
+    value_log(const value_log&) = delete;
+    value_log& operator=(const value_log&) = delete;
+
+    value_log(value_log&& other) noexcept
+        : path_(std::move(other.path_)), fd_(std::exchange(other.fd_, -1)),
+          size_(std::exchange(other.size_, 0)), dead_(std::exchange(other.dead_, 0)) {}
+
+    value_log& operator=(value_log&& other) noexcept {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            fd_ = std::exchange(other.fd_, -1);
+            size_ = std::exchange(other.size_, 0);
+            dead_ = std::exchange(other.dead_, 0);
+        }
+        return *this;
+    }
+
+    ~value_log() {
+        close();
+    }
+
+    value_locator append(std::string_view bytes) {
+        if (bytes.size() > UINT32_MAX) {
+            throw std::out_of_range("Value exceeds value log record size");
+        }
+        value_locator locator{size_, static_cast<uint32_t>(bytes.size())};
+        size_t written = 0;
+        while (written < bytes.size()) {
+            ssize_t n = ::pwrite(fd_, bytes.data() + written, bytes.size() - written,
+                                 static_cast<off_t>(size_ + written));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno("Cannot write value log");
+            }
+            written += static_cast<size_t>(n);
+        }
+        size_ += bytes.size();
+        return locator;
+    }
+
+    std::string read(value_locator locator) const {
+        if (locator.offset + locator.length > size_) {
+            throw std::out_of_range("Value locator outside of value log");
+        }
+        std::string value(locator.length, '\0');
+        size_t done = 0;
+        while (done < value.size()) {
+            ssize_t n = ::pread(fd_, value.data() + done, value.size() - done,
+                                static_cast<off_t>(locator.offset + done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno("Cannot read value log");
+            }
+            if (n == 0) {
+                throw std::runtime_error("Unexpected end of value log");
+            }
+            done += static_cast<size_t>(n);
+        }
+        return value;
+    }
+
+    /// Помечает значение как мертвое
+    void release(value_locator locator) noexcept {
+        dead_ += locator.length;
+    }
+
+    void sync() {
+        if (::fdatasync(fd_) != 0) {
+            throw_errno("Cannot sync value log");
+        }
+    }
+
+    /// Заменяет файл журнала файлом other и удаляет путь other
+    void replace_with(value_log&& other) {
+        if (::rename(other.path_.c_str(), path_.c_str()) != 0) {
+            throw_errno("Cannot replace value log");
+        }
+        other.path_ = path_;
+        *this = std::move(other);
+    }
+
+    const std::string& path() const noexcept {
+        return path_;
+    }
+
+    /// Размер журнала в байтах
+    uint64_t size_bytes() const noexcept {
+        return size_;
+    }
+
+    /// Байт, занятых освобожденными значениями
+    uint64_t dead_bytes() const noexcept {
+        return dead_;
+    }
+
+private:
+    void close() noexcept {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    [[noreturn]] void throw_errno(const char* what) const {
+        throw std::runtime_error(std::string(what) + " '" + path_ + "': " + std::strerror(errno));
+    }
+
+    std::string path_;
+    int fd_ = -1;
+    uint64_t size_ = 0;
+    uint64_t dead_ = 0;
+};
+
+} // namespace stl
+
+#endif // VALUE_LOG_HPP
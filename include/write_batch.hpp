@@ -0,0 +1,88 @@
+/**
+ * @file write_batch.hpp
+ * @brief Пакет вставок и удалений, применяемый к списку атомарно
+ * @author STL Container Implementation
+ * @version 1.0
+ * @date 2024
+ */
+
+#ifndef WRITE_BATCH_HPP
+#define WRITE_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace stl {
+
+/**
+ * @brief Набор изменений для apply_batch() конкурентных списков
+ *
+ * Операции накапливаются в порядке добавления; перед применением пакет
+ * сортируется по ключу, и для каждого ключа остается последняя операция.
+ */
+template<typename T>
+class write_batch {
+public:
+    enum class op_type { insert, erase };
+
+    struct operation {
+        op_type op;
+        T value;
+    };
+
+    using size_type = std::size_t;
+
+    write_batch& insert(T value) {
+        operations_.push_back({op_type::insert, std::move(value)});
+        return *this;
+    }
+
+    write_batch& erase(T key) {
+        operations_.push_back({op_type::erase, std::move(key)});
+        return *this;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return operations_.empty();
+    }
+
+    size_type size() const noexcept {
+        return operations_.size();
+    }
+
+    void clear() noexcept {
+        operations_.clear();
+    }
+
+    /**
+     * @brief Сортирует операции по ключу и убирает перекрытые
+     * @return Операции в порядке возрастания ключей, по одной на ключ
+     */
+    template<typename Compare>
+    std::vector<operation>& normalize(const Compare& comp) {
+        std::stable_sort(operations_.begin(), operations_.end(),
+            [&comp](const operation& a, const operation& b) { return comp(a.value, b.value); });
+
+        std::vector<operation> result;
+        result.reserve(operations_.size());
+        for (auto& operation : operations_) {
+            if (!result.empty() && !comp(result.back().value, operation.value)) {
+                result.back() = std::move(operation);
+            } else {
+                result.push_back(std::move(operation));
+            }
+        }
+        operations_ = std::move(result);
+        return operations_;
+    }
+
+private:
+    std::vector<operation> operations_;
+};
+
+} // namespace stl
+
+#endif // WRITE_BATCH_HPP
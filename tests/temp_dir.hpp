@@ -0,0 +1,60 @@
+/**
+ * @file temp_dir.hpp
+ * @brief Временный каталог для тестов, работающих с файлами
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef TESTS_TEMP_DIR_HPP
+#define TESTS_TEMP_DIR_HPP
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+namespace test {
+
+/**
+ * @brief Пустой каталог во временной директории, удаляемый деструктором
+ *
+ * Имя включает pid, чтобы параллельные запуски тестов не мешали друг другу.
+ */
+class temp_dir {
+public:
+    explicit temp_dir(const std::string& name)
+        : path_(std::filesystem::temp_directory_path() /
+                (name + "_" + std::to_string(::getpid()))) {
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+
+    temp_dir(const temp_dir&) = delete;
+    temp_dir& operator=(const temp_dir&) = delete;
+
+    ~temp_dir() {
+        std::error_code ignored;
+        std::filesystem::remove_all(path_, ignored);
+    }
+
+    const std::filesystem::path& path() const noexcept {
+        return path_;
+    }
+
+    /// Путь к файлу name внутри каталога
+    std::string file(const std::string& name) const {
+        return (path_ / name).string();
+    }
+
+    bool empty() const {
+        return std::filesystem::is_empty(path_);
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+} // namespace test
+
+#endif // TESTS_TEMP_DIR_HPP
@@ -0,0 +1,94 @@
+/**
+ * @file test_b_skip_list.cpp
+ * @brief Тесты для B-списка с пропусками
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/b_skip_list.hpp"
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+class BSkipListTest : public ::testing::Test {
+protected:
+    // Малые узлы дают много уровней, разбиений и слияний
+    using small_list = b_skip_list<int, std::less<int>, 16>;
+
+    template<typename List>
+    static void expect_matches(const List& sl, const std::set<int>& reference) {
+        ASSERT_EQ(sl.size(), reference.size());
+        EXPECT_TRUE(std::equal(sl.begin(), sl.end(), reference.begin(), reference.end()));
+    }
+};
+
+TEST_F(BSkipListTest, BasicOperations) {
+    b_skip_list<int> sl = {5, 1, 9, 3};
+    EXPECT_EQ(sl.size(), 4);
+    EXPECT_FALSE(sl.insert(5).second);
+    EXPECT_EQ(*sl.insert(7).first, 7);
+    EXPECT_EQ(*sl.lower_bound(4), 5);
+    EXPECT_EQ(*sl.upper_bound(5), 7);
+    EXPECT_EQ(sl.upper_bound(9), sl.end());
+    EXPECT_EQ(sl.erase(5), 1);
+    EXPECT_EQ(sl.erase(5), 0);
+    EXPECT_EQ(std::vector<int>(sl.begin(), sl.end()), (std::vector<int>{1, 3, 7, 9}));
+
+    sl.clear();
+    EXPECT_TRUE(sl.empty());
+    EXPECT_EQ(sl.begin(), sl.end());
+    EXPECT_TRUE(sl.insert(2).second);
+    EXPECT_TRUE(sl.contains(2));
+}
+
+TEST_F(BSkipListTest, MatchesReferenceUnderRandomOperations) {
+    small_list sl;
+    std::set<int> reference;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(0, 5000);
+    for (int i = 0; i < 40000; ++i) {
+        int key = dist(gen);
+        if (gen() % 3 == 0) {
+            ASSERT_EQ(sl.erase(key), reference.erase(key));
+        } else {
+            auto [it, inserted] = sl.insert(key);
+            ASSERT_EQ(inserted, reference.insert(key).second);
+            ASSERT_EQ(*it, key);
+        }
+    }
+    EXPECT_GT(sl.levels(), 2);
+    expect_matches(sl, reference);
+
+    for (int key = -1; key <= 5001; ++key) {
+        auto lower = reference.lower_bound(key);
+        auto found = sl.lower_bound(key);
+        if (lower == reference.end()) {
+            ASSERT_EQ(found, sl.end());
+        } else {
+            ASSERT_EQ(*found, *lower);
+        }
+        ASSERT_EQ(sl.count(key), reference.count(key));
+    }
+
+    // Удаление всех ключей сливает узлы и снимает лишние уровни
+    for (int key : std::vector<int>(reference.begin(), reference.end())) {
+        ASSERT_EQ(sl.erase(key), 1);
+    }
+    EXPECT_TRUE(sl.empty());
+    EXPECT_EQ(sl.levels(), 1);
+}
+
+TEST_F(BSkipListTest, CustomComparatorAndStrings) {
+    b_skip_list<std::string, std::greater<std::string>, 64> sl = {"b", "d", "a", "c"};
+    EXPECT_EQ(std::vector<std::string>(sl.begin(), sl.end()),
+              (std::vector<std::string>{"d", "c", "b", "a"}));
+    EXPECT_EQ(*sl.lower_bound("bb"), "b");
+    EXPECT_EQ(sl.erase("c"), 1);
+    EXPECT_EQ(sl.find("c"), sl.end());
+}
@@ -0,0 +1,124 @@
+/**
+ * @file test_change_feed.cpp
+ * @brief Тесты для журнала изменений skip_list
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/change_feed.hpp"
+#include "../include/skip_list.hpp"
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace stl;
+
+class ChangeFeedTest : public ::testing::Test {
+protected:
+    // Производное представление: ключи не меньше lo
+    static void apply(std::set<int>& view, const std::vector<change_event<int>>& events, int lo) {
+        for (const auto& event : events) {
+            if (event.op == change_op::clear) {
+                view.clear();
+            } else if (event.value >= lo) {
+                if (event.op == change_op::insert) {
+                    view.insert(event.value);
+                } else {
+                    view.erase(event.value);
+                }
+            }
+        }
+    }
+
+    static std::set<int> scan(const skip_list<int>& list, int lo) {
+        return std::set<int>(list.lower_bound(lo), list.end());
+    }
+};
+
+TEST_F(ChangeFeedTest, ConsumerFollowsListIncrementally) {
+    change_feed<int> feed(1024);
+    skip_list<int> sl;
+    change_publisher<skip_list<int>> publisher(sl, feed);
+    change_consumer<int> consumer(feed);
+    std::set<int> view;
+
+    std::mt19937 gen(124);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    std::vector<change_event<int>> events;
+    for (int i = 0; i < 10000; ++i) {
+        int key = dist(gen);
+        if (i % 3 == 0) {
+            sl.erase(key);
+        } else {
+            sl.insert(key);
+        }
+        if (i == 5000) {
+            sl.clear();
+        }
+        if (i % 100 == 0) {
+            events.clear();
+            ASSERT_TRUE(consumer.poll(events));
+            apply(view, events, 0);
+            ASSERT_EQ(consumer.lag(), 0);
+        }
+    }
+    events.clear();
+    ASSERT_TRUE(consumer.poll(events));
+    apply(view, events, 0);
+    EXPECT_EQ(view, scan(sl, 0));
+
+    // Неудачные вставки и удаления событий не порождают
+    uint64_t before = feed.next_sequence();
+    sl.insert(*sl.begin());
+    sl.erase(-1);
+    EXPECT_EQ(feed.next_sequence(), before);
+}
+
+TEST_F(ChangeFeedTest, LaggingConsumerResyncsFromRangeScan) {
+    change_feed<int> feed(8);
+    skip_list<int> sl;
+    change_publisher<skip_list<int>> publisher(sl, feed);
+    change_consumer<int> consumer(feed);
+    std::set<int> view;
+
+    for (int i = 0; i < 20; ++i) {
+        sl.insert(i);
+    }
+    std::vector<change_event<int>> events;
+    uint64_t position = consumer.position();
+    EXPECT_FALSE(consumer.poll(events));
+    EXPECT_TRUE(events.empty());
+    EXPECT_EQ(consumer.position(), position);
+    EXPECT_EQ(feed.oldest_sequence(), 12);
+
+    consumer.resync();
+    view = scan(sl, 10);
+    sl.erase(15);
+    sl.insert(25);
+    sl.insert(-5);
+    ASSERT_TRUE(consumer.poll(events, 2));
+    EXPECT_EQ(events.size(), 2);
+    ASSERT_TRUE(consumer.poll(events));
+    EXPECT_EQ(events.size(), 3);
+    apply(view, events, 10);
+    EXPECT_EQ(view, scan(sl, 10));
+}
+
+TEST_F(ChangeFeedTest, FeedFollowsMovedContents) {
+    EXPECT_THROW(change_feed<int>(0), std::out_of_range);
+
+    change_feed<int> feed(16);
+    skip_list<int> source;
+    change_publisher<skip_list<int>> publisher(source, feed);
+    source.insert(1);
+    skip_list<int> target(std::move(source));
+    target.insert(2);
+    EXPECT_EQ(feed.next_sequence(), 2);
+
+    uint64_t ahead = feed.next_sequence() + 1;
+    std::vector<change_event<int>> events;
+    EXPECT_THROW(feed.read(ahead, events, 1), std::out_of_range);
+}
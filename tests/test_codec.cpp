@@ -0,0 +1,78 @@
+/**
+ * @file test_codec.cpp
+ * @brief Тесты для кодеков выгружаемых диапазонов
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/codec.hpp"
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+class CodecTest : public ::testing::Test {
+protected:
+    template<typename Codec, typename T>
+    static void expect_round_trip(const std::vector<T>& values) {
+        std::string bytes = Codec::encode(values);
+        EXPECT_EQ(Codec::decode(bytes), values);
+    }
+};
+
+TEST_F(CodecTest, DeltaVarintRoundTripsAndShrinksDenseKeys) {
+    std::vector<int64_t> dense;
+    for (int64_t i = 0; i < 10000; ++i) {
+        dense.push_back(1000000 + 3 * i);
+    }
+    expect_round_trip<delta_varint_codec<int64_t>>(dense);
+    EXPECT_LT(delta_varint_codec<int64_t>::encode(dense).size(), dense.size() * 2);
+
+    // Отрицательные, убывающие и крайние значения тоже кодируются
+    expect_round_trip<delta_varint_codec<int64_t>>(std::vector<int64_t>{
+        std::numeric_limits<int64_t>::min(), -5, 7, std::numeric_limits<int64_t>::max(), 0});
+    expect_round_trip<delta_varint_codec<uint32_t>>(
+        std::vector<uint32_t>{0, 1, std::numeric_limits<uint32_t>::max(), 2});
+    expect_round_trip<delta_varint_codec<int>>(std::vector<int>{});
+}
+
+TEST_F(CodecTest, LzRoundTripsAndCompressesRepetitiveData) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 2000; ++i) {
+        keys.push_back("user:session:" + std::to_string(100000 + i));
+    }
+    expect_round_trip<lz_codec<string_codec>>(keys);
+    EXPECT_LT(lz_codec<string_codec>::encode(keys).size(),
+              string_codec::encode(keys).size() / 2);
+
+    std::mt19937 gen(120);
+    std::vector<uint32_t> noise(5000);
+    for (auto& value : noise) {
+        value = static_cast<uint32_t>(gen());
+    }
+    expect_round_trip<lz_codec<raw_codec<uint32_t>>>(noise);
+    expect_round_trip<lz_codec<raw_codec<uint32_t>>>(std::vector<uint32_t>(4096, 7));
+    expect_round_trip<lz_codec<raw_codec<uint32_t>>>(std::vector<uint32_t>{});
+}
+
+TEST_F(CodecTest, CorruptedBlocksThrow) {
+    EXPECT_THROW(raw_codec<int>::decode(std::string(5, 'x')), std::runtime_error);
+    EXPECT_THROW(string_codec::decode(std::string("\x05" "ab")), std::runtime_error);
+    EXPECT_THROW(delta_varint_codec<int>::decode(std::string("\x80")), std::runtime_error);
+
+    std::string block = lz_codec<string_codec>::encode(std::vector<std::string>(50, "repeat"));
+    EXPECT_THROW(lz_codec<string_codec>::decode(block.substr(0, block.size() / 2)),
+                 std::runtime_error);
+    // Смещение за начало распакованных данных
+    std::string bad;
+    detail::put_varint(bad, 8);
+    detail::put_varint(bad, 0);
+    detail::put_varint(bad, 8);
+    detail::put_varint(bad, 4);
+    EXPECT_THROW(detail::lz_decompress(bad), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+/**
+ * @file test_concurrency_stats.cpp
+ * @brief Тесты для счетчиков конкуренции
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/concurrency_stats.hpp"
+#include "../include/left_right_skip_list.hpp"
+#include "../include/nohotspot_skip_list.hpp"
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace stl;
+
+class ConcurrencyStatsTest : public ::testing::Test {
+protected:
+    static uint64_t total(const wait_histogram::counts& counts) {
+        return std::accumulate(counts.begin(), counts.end(), uint64_t{0});
+    }
+};
+
+TEST_F(ConcurrencyStatsTest, HistogramBucketsByPowerOfTwo) {
+    wait_histogram histogram;
+    histogram.record(std::chrono::nanoseconds(0));
+    histogram.record(std::chrono::nanoseconds(1));
+    histogram.record(std::chrono::nanoseconds(5));
+    histogram.record(std::chrono::nanoseconds(7));
+    histogram.record(std::chrono::hours(1000));
+
+    auto counts = histogram.read();
+    EXPECT_EQ(counts[0], 1);
+    EXPECT_EQ(counts[1], 1);
+    EXPECT_EQ(counts[3], 2);
+    EXPECT_EQ(counts[wait_histogram::BUCKETS - 1], 1);
+}
+
+TEST_F(ConcurrencyStatsTest, CountersAccumulate) {
+    concurrency_stats stats;
+    stats.cas_failure(0);
+    stats.cas_failure(2);
+    stats.cas_failure(1000);
+    stats.head_cas_failure();
+    stats.restart();
+    stats.scan_retry();
+
+    auto snapshot = stats.read();
+    EXPECT_EQ(snapshot.cas_failures[0], 1);
+    EXPECT_EQ(snapshot.cas_failures[2], 1);
+    EXPECT_EQ(snapshot.cas_failures[concurrency_stats::LEVELS - 1], 1);
+    EXPECT_EQ(snapshot.total_cas_failures(), 4);
+    EXPECT_EQ(snapshot.restarts, 1);
+    EXPECT_EQ(snapshot.scan_retries, 1);
+}
+
+TEST_F(ConcurrencyStatsTest, LeftRightRecordsEveryWrite) {
+    left_right_skip_list<int> sl;
+    for (int i = 0; i < 10; ++i) {
+        sl.insert(i);
+    }
+
+    auto snapshot = sl.stats();
+    EXPECT_EQ(total(snapshot.lock_wait), 10);
+    // Каждая запись дважды ждет опустения индикатора читателей
+    EXPECT_EQ(total(snapshot.drain_wait), 20);
+}
+
+TEST_F(ConcurrencyStatsTest, NohotspotReportsReclamationBacklog) {
+    nohotspot_skip_list<int> sl(std::chrono::microseconds(0));
+    for (int i = 0; i < 100; ++i) {
+        sl.insert(i);
+    }
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&sl, t] {
+            for (int i = 0; i < 2000; ++i) {
+                sl.insert(1000 + (i * 4 + t) % 64);
+                sl.erase(1000 + (i * 4 + t + 1) % 64);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        sl.erase(i);
+    }
+    {
+        auto guard = sl.begin();
+        sl.maintain();
+        // Закрепленный итератор не дает освободить отсоединенные узлы
+        EXPECT_GT(sl.stats().reclamation_backlog, 0);
+    }
+    sl.maintain();
+    EXPECT_EQ(sl.stats().reclamation_backlog, 0);
+}
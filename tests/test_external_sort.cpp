@@ -0,0 +1,127 @@
+/**
+ * @file test_external_sort.cpp
+ * @brief Тесты для внешней сортировки на skip_list
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/external_sort.hpp"
+#include "temp_dir.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace stl;
+
+// raw_codec, который отказывает на заданном чтении блока
+struct failing_codec {
+    static inline int decodes_left = -1;
+
+    static std::string encode(const std::vector<int>& values) {
+        return raw_codec<int>::encode(values);
+    }
+
+    static std::vector<int> decode(std::string_view bytes) {
+        if (decodes_left >= 0 && decodes_left-- == 0) {
+            throw std::runtime_error("Injected decode failure");
+        }
+        return raw_codec<int>::decode(bytes);
+    }
+};
+
+class ExternalSortTest : public ::testing::Test {
+protected:
+    external_sort_options options(size_t memory, size_t fanout) const {
+        return external_sort_options{dir_.path().string(), memory, fanout};
+    }
+
+    test::temp_dir dir_{"external_sort"};
+};
+
+TEST_F(ExternalSortTest, SortsRandomInputWithDuplicates) {
+    std::vector<int> input(200000);
+    std::mt19937 gen(125);
+    std::uniform_int_distribution<int> dist(0, 50000);
+    for (auto& value : input) {
+        value = dist(gen);
+    }
+
+    std::vector<int> output;
+    {
+        external_sorter<int> sorter(options(5000, 4));
+        for (int value : input) {
+            sorter.push(value);
+        }
+        sorter.finish([&output](int value) { output.push_back(value); });
+        EXPECT_EQ(sorter.size(), input.size());
+        // Замещающий выбор дает серии около двух объемов памяти
+        EXPECT_LE(sorter.initial_runs(), input.size() / (5000 * 3 / 2));
+        EXPECT_GT(sorter.merge_passes(), 1);
+    }
+    std::sort(input.begin(), input.end());
+    EXPECT_EQ(output, input);
+    EXPECT_TRUE(dir_.empty());
+}
+
+TEST_F(ExternalSortTest, PresortedInputFormsOneRun) {
+    external_sorter<int> ascending(options(100, 8));
+    for (int i = 0; i < 10000; ++i) {
+        ascending.push(i);
+    }
+    size_t count = 0;
+    ascending.finish([&count](int value) { EXPECT_EQ(value, static_cast<int>(count++)); });
+    EXPECT_EQ(count, 10000);
+    EXPECT_EQ(ascending.initial_runs(), 1);
+
+    // Обратный порядок - худший случай: серии размером с память
+    external_sorter<int> descending(options(100, 8));
+    for (int i = 10000; i-- > 0;) {
+        descending.push(i);
+    }
+    count = 0;
+    descending.finish([&count](int value) { EXPECT_EQ(value, static_cast<int>(count++)); });
+    EXPECT_EQ(descending.initial_runs(), 100);
+
+    external_sorter<int> empty(options(100, 8));
+    empty.finish([](int) { FAIL(); });
+    EXPECT_EQ(empty.initial_runs(), 0);
+}
+
+TEST_F(ExternalSortTest, SortsStringsWithCustomOrder) {
+    std::vector<std::string> input;
+    for (int i = 0; i < 3000; ++i) {
+        input.push_back("key-" + std::to_string((i * 7919) % 1000));
+    }
+    external_sorter<std::string, std::greater<std::string>, string_codec> sorter(options(64, 2));
+    for (const auto& value : input) {
+        sorter.push(value);
+    }
+    std::vector<std::string> output;
+    sorter.finish([&output](const std::string& value) { output.push_back(value); });
+    std::sort(input.begin(), input.end(), std::greater<std::string>());
+    EXPECT_EQ(output, input);
+
+    EXPECT_THROW(sorter.push("late"), std::runtime_error);
+    EXPECT_THROW(external_sorter<int>(options(0, 4)), std::out_of_range);
+    EXPECT_THROW(external_sorter<int>(options(16, 1)), std::out_of_range);
+}
+
+TEST_F(ExternalSortTest, FailedMergePassRemovesItsOutputs) {
+    {
+        external_sorter<int, std::less<int>, failing_codec> sorter(options(100, 2));
+        for (int i = 10000; i-- > 0;) {
+            sorter.push(i);
+        }
+        // Первые пары серий проход успевает слить до отказа
+        failing_codec::decodes_left = 20;
+        EXPECT_THROW(sorter.finish([](int) {}), std::runtime_error);
+        failing_codec::decodes_left = -1;
+        EXPECT_FALSE(dir_.empty());
+    }
+    EXPECT_TRUE(dir_.empty());
+}
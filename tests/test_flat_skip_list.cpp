@@ -0,0 +1,92 @@
+/**
+ * @file test_flat_skip_list.cpp
+ * @brief Тесты для списка с пропусками в одном буфере памяти
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/flat_skip_list.hpp"
+#include "../include/persistent_skip_list.hpp"
+#include "temp_dir.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+class FlatSkipListTest : public ::testing::Test {
+protected:
+    template<typename List>
+    static std::vector<int> contents(const List& list) {
+        return std::vector<int>(list.begin(), list.end());
+    }
+};
+
+TEST_F(FlatSkipListTest, MatchesReference) {
+    flat_skip_list<int, std::greater<int>> sl;
+    std::set<int, std::greater<int>> reference;
+    std::mt19937 gen(122);
+    std::uniform_int_distribution<int> dist(0, 5000);
+    for (int i = 0; i < 20000; ++i) {
+        int key = dist(gen);
+        if (i % 3 == 0) {
+            ASSERT_EQ(sl.erase(key), reference.erase(key));
+        } else {
+            ASSERT_EQ(sl.insert(key).second, reference.insert(key).second);
+        }
+    }
+    EXPECT_EQ(sl.size(), reference.size());
+    EXPECT_TRUE(std::equal(sl.begin(), sl.end(), reference.begin(), reference.end()));
+    EXPECT_EQ(*sl.lower_bound(5001), *reference.lower_bound(5001));
+    EXPECT_EQ(sl.upper_bound(-1), sl.end());
+}
+
+TEST_F(FlatSkipListTest, CopiesAreIndependent) {
+    flat_skip_list<int> original{5, 1, 3};
+    for (int i = 10; i < 1000; ++i) {
+        original.insert(i);
+    }
+
+    flat_skip_list<int> copy(original);
+    EXPECT_EQ(contents(copy), contents(original));
+    EXPECT_EQ(copy.heap_bytes(), original.heap_bytes());
+
+    copy.erase(3);
+    copy.insert(2);
+    original.insert(4);
+    EXPECT_TRUE(copy.contains(2));
+    EXPECT_FALSE(copy.contains(3));
+    EXPECT_FALSE(copy.contains(4));
+    EXPECT_TRUE(original.contains(3));
+    EXPECT_FALSE(original.contains(2));
+
+    // Присваивание переиспользует буфер, если его хватает
+    flat_skip_list<int> target;
+    for (int i = 0; i < 5000; ++i) {
+        target.insert(i);
+    }
+    size_t capacity = target.capacity_bytes();
+    target = original;
+    EXPECT_EQ(target.capacity_bytes(), capacity);
+    EXPECT_EQ(contents(target), contents(original));
+    target.insert(-1);
+    EXPECT_EQ(target.size(), original.size() + 1);
+}
+
+TEST_F(FlatSkipListTest, ClonesPersistentList) {
+    test::temp_dir dir("flat_skip_list");
+    persistent_skip_list<int> persistent(dir.file("list.heap"));
+    for (int i = 0; i < 100; ++i) {
+        persistent.insert(i * 2);
+    }
+    flat_skip_list<int> what_if(persistent);
+    what_if.insert(1);
+    EXPECT_EQ(what_if.size(), 101);
+    EXPECT_FALSE(persistent.contains(1));
+    EXPECT_EQ(contents(persistent).size(), 100);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file test_intrusive_skip_list.cpp
+ * @brief Тесты для интрузивного списка с пропусками
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/intrusive_skip_list.hpp"
+#include <array>
+#include <deque>
+#include <functional>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace stl;
+
+namespace {
+
+struct order {
+    int id = 0;
+    std::array<char, 200> payload{};
+    skip_list_hook<order> by_id;
+
+    explicit order(int i = 0) : id(i) {}
+
+    bool operator<(const order& other) const {
+        return id < other.id;
+    }
+
+    bool operator>(const order& other) const {
+        return id > other.id;
+    }
+};
+
+using order_list = intrusive_skip_list<order, &order::by_id>;
+
+} // namespace
+
+class IntrusiveSkipListTest : public ::testing::Test {
+protected:
+    static std::vector<int> ids(const order_list& list) {
+        std::vector<int> result;
+        for (const auto& o : list) {
+            result.push_back(o.id);
+        }
+        return result;
+    }
+};
+
+TEST_F(IntrusiveSkipListTest, LinksObjectsInPlace) {
+    std::deque<order> pool;
+    for (int id : {5, 1, 9, 3}) {
+        pool.emplace_back(id);
+    }
+
+    order_list list;
+    for (auto& o : pool) {
+        auto [it, inserted] = list.insert(o);
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(&*it, &o);
+        EXPECT_TRUE(o.by_id.is_linked());
+    }
+    EXPECT_EQ(ids(list), (std::vector<int>{1, 3, 5, 9}));
+
+    order twin(5);
+    auto [it, inserted] = list.insert(twin);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(&*it, &pool[0]);
+    EXPECT_FALSE(twin.by_id.is_linked());
+    EXPECT_THROW(list.insert(pool[1]), std::runtime_error);
+
+    EXPECT_EQ(&*list.find(order(9)), &pool[2]);
+    EXPECT_EQ(list.lower_bound(order(4))->id, 5);
+    EXPECT_EQ(list.erase(order(3)), 1);
+    EXPECT_FALSE(pool[3].by_id.is_linked());
+    EXPECT_THROW(list.unlink(twin), std::out_of_range);
+    list.unlink(pool[0]);
+    EXPECT_EQ(ids(list), (std::vector<int>{1, 9}));
+
+    // Объект можно снова связать после отвязывания
+    EXPECT_TRUE(list.insert(pool[0]).second);
+    EXPECT_EQ(list.size(), 3);
+}
+
+TEST_F(IntrusiveSkipListTest, MatchesReferenceUnderRandomOperations) {
+    std::vector<order> pool(2000);
+    for (int i = 0; i < 2000; ++i) {
+        pool[i].id = i;
+    }
+
+    order_list list;
+    std::set<int> reference;
+    std::mt19937 gen(11);
+    for (int step = 0; step < 20000; ++step) {
+        order& o = pool[gen() % pool.size()];
+        if (o.by_id.is_linked()) {
+            list.unlink(o);
+            reference.erase(o.id);
+        } else {
+            ASSERT_TRUE(list.insert(o).second);
+            reference.insert(o.id);
+        }
+    }
+    ASSERT_EQ(list.size(), reference.size());
+    EXPECT_EQ(ids(list), std::vector<int>(reference.begin(), reference.end()));
+}
+
+TEST_F(IntrusiveSkipListTest, ClearMoveAndDestructionUnlinkHooks) {
+    order a(1);
+    order b(2);
+    {
+        intrusive_skip_list<order, &order::by_id, std::greater<order>> list;
+        list.insert(a);
+        list.insert(b);
+        EXPECT_EQ(list.begin()->id, 2);
+
+        auto moved = std::move(list);
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(moved.size(), 2);
+        EXPECT_TRUE(moved.contains(a));
+    }
+    EXPECT_FALSE(a.by_id.is_linked());
+    EXPECT_FALSE(b.by_id.is_linked());
+
+    order_list list;
+    list.insert(a);
+    order copy = a;
+    EXPECT_FALSE(copy.by_id.is_linked());
+    list.clear();
+    EXPECT_FALSE(a.by_id.is_linked());
+    EXPECT_TRUE(list.empty());
+}
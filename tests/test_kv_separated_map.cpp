@@ -0,0 +1,130 @@
+/**
+ * @file test_kv_separated_map.cpp
+ * @brief Тесты для отображения со значениями в журнале на диске
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/kv_separated_map.hpp"
+#include "temp_dir.hpp"
+#include <filesystem>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace stl;
+
+class KvSeparatedMapTest : public ::testing::Test {
+protected:
+    static std::string blob(int key, int version) {
+        return std::string(4096, static_cast<char>('a' + (key + version) % 26)) +
+               std::to_string(key) + "/" + std::to_string(version);
+    }
+
+    test::temp_dir dir_{"kv_separated_map"};
+    std::string path_ = dir_.file("values.log");
+};
+
+TEST_F(KvSeparatedMapTest, StoresValuesInLog) {
+    kv_separated_map<int> map(path_);
+    EXPECT_TRUE(map.insert_or_assign(2, blob(2, 0)));
+    EXPECT_TRUE(map.insert_or_assign(1, blob(1, 0)));
+    EXPECT_FALSE(map.insert_or_assign(2, blob(2, 1)));
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.get(2), blob(2, 1));
+    EXPECT_EQ(map.get(3), std::nullopt);
+    EXPECT_EQ(map.dead_bytes(), blob(2, 0).size());
+    EXPECT_EQ(std::filesystem::file_size(path_), map.log_bytes());
+
+    std::vector<int> keys;
+    map.for_each([&](int key, const std::string& value) {
+        keys.push_back(key);
+        EXPECT_EQ(value, blob(key, key == 2 ? 1 : 0));
+    });
+    EXPECT_EQ(keys, (std::vector<int>{1, 2}));
+
+    EXPECT_EQ(map.erase(1), 1);
+    EXPECT_EQ(map.erase(1), 0);
+    EXPECT_FALSE(map.contains(1));
+}
+
+TEST_F(KvSeparatedMapTest, ErasesDriveGarbageCollection) {
+    kv_separated_map<int> map(path_, 0.5, 64 * 1024);
+    std::map<int, int> versions;
+    std::mt19937 gen(17);
+    for (int step = 0; step < 3000; ++step) {
+        int key = static_cast<int>(gen() % 200);
+        if (gen() % 4 == 0) {
+            ASSERT_EQ(map.erase(key), versions.erase(key));
+        } else {
+            map.insert_or_assign(key, blob(key, step));
+            versions[key] = step;
+        }
+        // Журнал не растет без ограничения: мертвые байты собираются
+        ASSERT_LE(map.dead_bytes(), map.log_bytes() / 2 + 64 * 1024);
+    }
+
+    ASSERT_EQ(map.size(), versions.size());
+    for (const auto& [key, version] : versions) {
+        ASSERT_EQ(map.get(key), blob(key, version));
+    }
+
+    map.collect_garbage();
+    EXPECT_EQ(map.dead_bytes(), 0);
+    EXPECT_FALSE(std::filesystem::exists(path_ + ".gc"));
+    EXPECT_EQ(std::filesystem::file_size(path_), map.log_bytes());
+    for (const auto& [key, version] : versions) {
+        ASSERT_EQ(map.get(key), blob(key, version));
+    }
+}
+
+TEST_F(KvSeparatedMapTest, FailedCollectionKeepsMutationResult) {
+    kv_separated_map<int> map(path_, 0.1, 0);
+    // Каталог на месте временного журнала: сборка мусора не может начаться
+    std::filesystem::create_directory(path_ + ".gc");
+    map.insert_or_assign(1, blob(1, 0));
+    map.insert_or_assign(2, blob(2, 0));
+
+    EXPECT_FALSE(map.insert_or_assign(1, blob(1, 1)));
+    EXPECT_EQ(map.gc_failures(), 1);
+    EXPECT_EQ(map.erase(2), 1);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.get(1), blob(1, 1));
+    EXPECT_THROW(map.collect_garbage(), std::runtime_error);
+
+    std::filesystem::remove(path_ + ".gc");
+    map.collect_garbage();
+    EXPECT_EQ(map.dead_bytes(), 0);
+    EXPECT_EQ(map.get(1), blob(1, 1));
+}
+
+TEST_F(KvSeparatedMapTest, FailedInsertCountsValueAsDead) {
+    // Сравнение ключа 13 бросает исключение, как сбой вставки в индекс
+    struct picky_less {
+        bool operator()(int a, int b) const {
+            if (a == 13 || b == 13) {
+                throw std::runtime_error("picky key");
+            }
+            return a < b;
+        }
+    };
+    kv_separated_map<int, picky_less> map(path_, 1.0);
+    map.insert_or_assign(1, blob(1, 0));
+
+    EXPECT_THROW(map.insert_or_assign(13, blob(13, 0)), std::runtime_error);
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(map.dead_bytes(), blob(13, 0).size());
+    EXPECT_EQ(map.get(1), blob(1, 0));
+}
+
+TEST_F(KvSeparatedMapTest, ReportsIoErrors) {
+    EXPECT_THROW(kv_separated_map<int>("/nonexistent-dir/values.log"), std::runtime_error);
+
+    value_log log(path_);
+    auto locator = log.append("payload");
+    EXPECT_EQ(log.read(locator), "payload");
+    EXPECT_THROW(log.read(value_locator{locator.offset, 100}), std::out_of_range);
+}
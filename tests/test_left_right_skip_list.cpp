@@ -0,0 +1,131 @@
+/**
+ * @file test_left_right_skip_list.cpp
+ * @brief Тесты для обертки Left-Right над списком с пропусками
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/left_right_skip_list.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace stl;
+
+class LeftRightSkipListTest : public ::testing::Test {
+};
+
+TEST_F(LeftRightSkipListTest, InsertEraseContains) {
+    left_right_skip_list<int> sl;
+    EXPECT_TRUE(sl.insert(3));
+    EXPECT_TRUE(sl.insert(1));
+    EXPECT_FALSE(sl.insert(3));
+
+    EXPECT_TRUE(sl.contains(1));
+    EXPECT_EQ(sl.size(), 2);
+
+    EXPECT_EQ(sl.erase(1), 1);
+    EXPECT_EQ(sl.erase(1), 0);
+    EXPECT_FALSE(sl.contains(1));
+
+    sl.clear();
+    EXPECT_TRUE(sl.empty());
+}
+
+TEST_F(LeftRightSkipListTest, ReadSeesWholeList) {
+    left_right_skip_list<int> sl = {5, 3, 1};
+
+    auto values = sl.read([](const auto& list) {
+        return std::vector<int>(list.begin(), list.end());
+    });
+    EXPECT_EQ(values, (std::vector<int>{1, 3, 5}));
+}
+
+TEST_F(LeftRightSkipListTest, BothCopiesStayInSync) {
+    left_right_skip_list<int> sl;
+    for (int i = 0; i < 100; ++i) {
+        sl.insert(i);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        sl.erase(i);
+    }
+
+    // Каждое изменение переключает активную копию, поэтому чтения
+    // после четного и нечетного числа записей видят разные экземпляры
+    size_t first = sl.size();
+    sl.insert(1000);
+    sl.erase(1000);
+    EXPECT_EQ(sl.size(), first);
+    sl.insert(1000);
+    EXPECT_EQ(sl.size(), first + 1);
+}
+
+TEST_F(LeftRightSkipListTest, ConcurrentReadersNeverSeeTornState) {
+    left_right_skip_list<int> sl;
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                sl.read([&](const auto& list) {
+                    int previous = -1;
+                    for (int value : list) {
+                        if (value <= previous) {
+                            ++errors;
+                        }
+                        previous = value;
+                    }
+                });
+            }
+        });
+    }
+
+    for (int i = 0; i < 300; ++i) {
+        sl.insert(i);
+        if (i % 2 == 1) {
+            sl.erase(i - 1);
+        }
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(sl.size(), 150);
+}
+
+TEST_F(LeftRightSkipListTest, ApplyBatchIsAtomicForReaders) {
+    left_right_skip_list<int> sl;
+    for (int i = 0; i < 32; ++i) {
+        sl.insert(i);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            if (sl.size() != 32) {
+                ++errors;
+            }
+        }
+    });
+
+    for (int round = 0; round < 100; ++round) {
+        write_batch<int> batch;
+        for (int i = 0; i < 32; ++i) {
+            batch.erase(round * 32 + i).insert(round * 32 + 32 + i);
+        }
+        EXPECT_EQ(sl.apply_batch(std::move(batch)), 64);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_TRUE(sl.contains(100 * 32));
+    EXPECT_FALSE(sl.contains(0));
+}
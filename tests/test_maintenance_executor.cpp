@@ -0,0 +1,177 @@
+/**
+ * @file test_maintenance_executor.cpp
+ * @brief Тесты для планировщика обслуживания и пошаговых процедур skip_list
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/maintenance_executor.hpp"
+#include "../include/skip_list.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace stl;
+
+class MaintenanceExecutorTest : public ::testing::Test {
+protected:
+    static std::chrono::microseconds no_thread() {
+        return std::chrono::microseconds(0);
+    }
+
+    static void expect_sorted_range(const skip_list<int>& sl, int first, int last) {
+        std::vector<int> expected;
+        for (int i = first; i < last; ++i) {
+            expected.push_back(i);
+        }
+        EXPECT_EQ(std::vector<int>(sl.begin(), sl.end()), expected);
+        for (int i = first; i < last; ++i) {
+            ASSERT_NE(sl.find(i), sl.end()) << i;
+        }
+    }
+};
+
+TEST_F(MaintenanceExecutorTest, InlineRunsTasksInSlices) {
+    maintenance_executor executor(no_thread());
+    int steps = 0;
+    executor.post([&steps](auto) { return ++steps < 5; });
+
+    EXPECT_EQ(executor.pending(), 1);
+    while (executor.run_for(std::chrono::microseconds(1))) {
+    }
+    EXPECT_EQ(steps, 5);
+    EXPECT_EQ(executor.pending(), 0);
+}
+
+TEST_F(MaintenanceExecutorTest, BackgroundThreadDrainsQueue) {
+    maintenance_executor executor(std::chrono::microseconds(100));
+    std::atomic<int> done{0};
+    for (int i = 0; i < 3; ++i) {
+        executor.post([&done](auto) {
+            ++done;
+            return false;
+        });
+    }
+    executor.wait_idle();
+    EXPECT_EQ(done.load(), 3);
+}
+
+TEST_F(MaintenanceExecutorTest, RebuildTowersPreservesContents) {
+    skip_list<int> sl;
+    for (int i = 0; i < 2000; ++i) {
+        sl.insert(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        sl.erase(i);
+    }
+
+    skip_list<int>::maintenance_cursor cursor;
+    while (!cursor.done) {
+        sl.rebuild_towers(cursor, 100);
+        // Между шагами список можно изменять
+        sl.insert(5000 + static_cast<int>(cursor.rank));
+        sl.erase(5000 + static_cast<int>(cursor.rank));
+    }
+    expect_sorted_range(sl, 1000, 2000);
+}
+
+TEST_F(MaintenanceExecutorTest, CompactPreservesContents) {
+    skip_list<int> sl;
+    for (int i = 999; i >= 0; --i) {
+        sl.insert(i);
+    }
+
+    maintenance_executor executor(no_thread());
+    executor.post(compact_task(sl, 16));
+    executor.post(rebuild_towers_task(sl, 16));
+    executor.wait_idle();
+
+    expect_sorted_range(sl, 0, 1000);
+    sl.insert(1000);
+    sl.erase(0);
+    expect_sorted_range(sl, 1, 1001);
+}
+
+TEST_F(MaintenanceExecutorTest, DeferredReleaseFreesOnIdle) {
+    auto less = [](const std::shared_ptr<int>& a, const std::shared_ptr<int>& b) {
+        return *a < *b;
+    };
+    skip_list<std::shared_ptr<int>, decltype(less)> sl;
+    sl.set_deferred_release(true);
+
+    std::vector<std::weak_ptr<int>> watched;
+    for (int i = 0; i < 100; ++i) {
+        auto value = std::make_shared<int>(i);
+        watched.push_back(value);
+        sl.insert(std::move(value));
+    }
+    sl.erase(std::make_shared<int>(50));
+    sl.clear();
+
+    EXPECT_TRUE(sl.has_retired());
+    EXPECT_FALSE(watched[50].expired());
+    EXPECT_FALSE(watched[0].expired());
+
+    std::mutex owner_mutex;
+    maintenance_executor executor(no_thread());
+    executor.post(locked(owner_mutex, release_retired_task(sl, 10)));
+    executor.wait_idle();
+
+    EXPECT_FALSE(sl.has_retired());
+    for (const auto& value : watched) {
+        EXPECT_TRUE(value.expired());
+    }
+}
+
+TEST_F(MaintenanceExecutorTest, ReleaseExecutorFreesAfterDestruction) {
+    auto less = [](const std::shared_ptr<int>& a, const std::shared_ptr<int>& b) {
+        return *a < *b;
+    };
+    maintenance_executor executor(no_thread());
+    std::vector<std::weak_ptr<int>> watched;
+    {
+        skip_list<std::shared_ptr<int>, decltype(less)> sl;
+        sl.set_release_executor(&executor);
+        for (int i = 0; i < 1000; ++i) {
+            auto value = std::make_shared<int>(i);
+            watched.push_back(value);
+            sl.insert(std::move(value));
+        }
+        sl.erase(std::make_shared<int>(10));
+    }
+
+    // Список уничтожен, но узлы освобождаются только задачей исполнителя
+    EXPECT_FALSE(watched[10].expired());
+    EXPECT_FALSE(watched[500].expired());
+    EXPECT_EQ(executor.pending(), 1);
+
+    executor.run_for(std::chrono::seconds(1));
+    executor.wait_idle();
+    for (const auto& value : watched) {
+        EXPECT_TRUE(value.expired());
+    }
+}
+
+TEST_F(MaintenanceExecutorTest, BackgroundReleaseOfLargeList) {
+    maintenance_executor executor(no_thread());
+    auto sl = std::make_unique<skip_list<int>>();
+    sl->set_release_executor(&executor);
+    for (int i = 0; i < 200000; ++i) {
+        sl->insert(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        sl->erase(i);
+    }
+
+    // Деструктор не освобождает цепочку сам, а ставит задачу в очередь
+    sl.reset();
+    EXPECT_EQ(executor.pending(), 1);
+
+    while (executor.run_for(std::chrono::milliseconds(1))) {
+    }
+    EXPECT_EQ(executor.pending(), 0);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_nohotspot_skip_list.cpp
+ * @brief Тесты для неблокирующего списка с пропусками без горячих точек
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/nohotspot_skip_list.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace stl;
+
+class NohotspotSkipListTest : public ::testing::Test {
+protected:
+    using manual_list = nohotspot_skip_list<int>;
+
+    static manual_list::const_iterator::difference_type length(const manual_list& sl) {
+        return std::distance(sl.begin(), sl.end());
+    }
+};
+
+TEST_F(NohotspotSkipListTest, InsertEraseContains) {
+    manual_list sl(std::chrono::microseconds(0));
+    EXPECT_TRUE(sl.insert(5));
+    EXPECT_TRUE(sl.insert(1));
+    EXPECT_FALSE(sl.insert(5));
+
+    EXPECT_TRUE(sl.contains(5));
+    EXPECT_EQ(sl.size(), 2);
+
+    EXPECT_EQ(sl.erase(5), 1);
+    EXPECT_EQ(sl.erase(5), 0);
+    EXPECT_FALSE(sl.contains(5));
+    EXPECT_EQ(sl.find(5), sl.end());
+    EXPECT_EQ(*sl.find(1), 1);
+}
+
+TEST_F(NohotspotSkipListTest, ReinsertRevivesDeletedNode) {
+    manual_list sl(std::chrono::microseconds(0));
+    sl.insert(7);
+    sl.erase(7);
+    EXPECT_TRUE(sl.insert(7));
+    EXPECT_TRUE(sl.contains(7));
+
+    sl.maintain();
+    EXPECT_TRUE(sl.contains(7));
+}
+
+TEST_F(NohotspotSkipListTest, MaintenanceBuildsAndLowersIndex) {
+    manual_list sl(std::chrono::microseconds(0));
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert(i);
+    }
+    EXPECT_EQ(sl.levels(), 0);
+
+    sl.maintain();
+    EXPECT_GT(sl.levels(), 3);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(sl.contains(i));
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        sl.erase(i);
+    }
+    sl.maintain();
+    EXPECT_EQ(sl.levels(), 0);
+    EXPECT_TRUE(sl.empty());
+}
+
+TEST_F(NohotspotSkipListTest, LowerBoundSkipsDeleted) {
+    manual_list sl(std::chrono::microseconds(0));
+    for (int i = 0; i < 10; ++i) {
+        sl.insert(i * 10);
+    }
+    sl.erase(30);
+
+    EXPECT_EQ(*sl.lower_bound(25), 40);
+    EXPECT_EQ(length(sl), 9);
+}
+
+TEST_F(NohotspotSkipListTest, ConcurrentWritersWithBackgroundMaintenance) {
+    nohotspot_skip_list<int> sl(std::chrono::microseconds(200));
+    constexpr int threads = 4;
+    constexpr int per_thread = 2000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&sl, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                sl.insert(i * threads + t);
+            }
+            for (int i = 0; i < per_thread; i += 2) {
+                sl.erase(i * threads + t);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(sl.size(), static_cast<size_t>(threads * per_thread / 2));
+    int previous = -1;
+    for (int value : sl) {
+        EXPECT_LT(previous, value);
+        previous = value;
+    }
+}
+
+TEST_F(NohotspotSkipListTest, ScanSkipsDeletedElements) {
+    manual_list sl(std::chrono::microseconds(0));
+    for (int i = 0; i < 10; ++i) {
+        sl.insert(i);
+    }
+    sl.erase(4);
+
+    EXPECT_EQ(sl.scan(3, 6), (std::vector<int>{3, 5, 6}));
+    sl.maintain();
+    EXPECT_EQ(sl.scan(3, 6), (std::vector<int>{3, 5, 6}));
+    EXPECT_EQ(sl.scan(20, 30), std::vector<int>{});
+}
+
+TEST_F(NohotspotSkipListTest, ScanIsConsistentUnderWrites) {
+    nohotspot_skip_list<int> sl(std::chrono::microseconds(100));
+    sl.insert(1001);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            if (sl.scan(1000, 2000).empty()) {
+                ++errors;
+            }
+        }
+    });
+
+    std::thread noise([&] {
+        for (int i = 0; i < 4000 && !done.load(); ++i) {
+            sl.insert(i % 1000);
+            sl.erase((i + 500) % 1000);
+        }
+    });
+
+    for (int marker = 1001; marker < 1999; ++marker) {
+        sl.insert(marker + 1);
+        sl.erase(marker);
+    }
+    done = true;
+    reader.join();
+    noise.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(sl.scan(1000, 2000), std::vector<int>{1999});
+}
@@ -0,0 +1,167 @@
+/**
+ * @file test_persistent_skip_list.cpp
+ * @brief Тесты для списка с пропусками в отображенном в память файле
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/persistent_skip_list.hpp"
+#include "temp_dir.hpp"
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace stl;
+
+class PersistentSkipListTest : public ::testing::Test {
+protected:
+    test::temp_dir dir_{"persistent_skip_list"};
+    std::string path_ = dir_.file("list.heap");
+};
+
+TEST_F(PersistentSkipListTest, MatchesReferenceAndSurvivesReopen) {
+    std::set<int64_t> reference;
+    {
+        persistent_skip_list<int64_t> sl(path_);
+        EXPECT_TRUE(sl.empty());
+        std::mt19937 gen(121);
+        std::uniform_int_distribution<int64_t> dist(-50000, 50000);
+        for (int i = 0; i < 30000; ++i) {
+            int64_t key = dist(gen);
+            if (i % 3 == 0) {
+                ASSERT_EQ(sl.erase(key), reference.erase(key));
+            } else {
+                ASSERT_EQ(sl.insert(key).second, reference.insert(key).second);
+            }
+        }
+        EXPECT_EQ(std::vector<int64_t>(sl.begin(), sl.end()),
+                  std::vector<int64_t>(reference.begin(), reference.end()));
+    }
+
+    persistent_skip_list<int64_t> sl(path_);
+    EXPECT_FALSE(sl.recovered());
+    EXPECT_EQ(sl.size(), reference.size());
+    EXPECT_EQ(std::vector<int64_t>(sl.begin(), sl.end()),
+              std::vector<int64_t>(reference.begin(), reference.end()));
+    for (int64_t key = -1000; key < 1000; ++key) {
+        auto expected = reference.lower_bound(key);
+        auto found = sl.lower_bound(key);
+        ASSERT_EQ(found == sl.end(), expected == reference.end());
+        if (found != sl.end()) {
+            ASSERT_EQ(*found, *expected);
+        }
+    }
+}
+
+TEST_F(PersistentSkipListTest, RecoversAfterProcessCrash) {
+    {
+        persistent_skip_list<int> sl(path_);
+        for (int i = 0; i < 1000; ++i) {
+            sl.insert(i);
+        }
+    }
+
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Обрыв без деструктора и контрольной точки
+        persistent_skip_list<int> sl(path_);
+        for (int i = 1000; i < 1500; ++i) {
+            sl.insert(i);
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            sl.erase(i);
+        }
+        ::_exit(0);
+    }
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+
+    persistent_skip_list<int> sl(path_);
+    EXPECT_TRUE(sl.recovered());
+    EXPECT_EQ(sl.size(), 1000);
+    std::vector<int> expected;
+    for (int i = 1; i < 1500; ++i) {
+        if (i >= 1000 || i % 2 == 1) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(std::vector<int>(sl.begin(), sl.end()), expected);
+
+    // Узлы удаленных ключей возвращены в свободные и переиспользуются
+    size_t heap = sl.heap_bytes();
+    for (int i = 0; i < 400; i += 2) {
+        sl.insert(i);
+    }
+    // Узел высоты без свободных выделяется заново, это единичные узлы
+    EXPECT_LT(sl.heap_bytes(), heap + 2000);
+}
+
+TEST_F(PersistentSkipListTest, MoveAssignmentCheckpointsReplacedFile) {
+    std::string other_path = dir_.file("other.heap");
+    persistent_skip_list<int> sl(path_);
+    sl.insert(1);
+    persistent_skip_list<int> other(other_path);
+    other.insert(2);
+    sl = std::move(other);
+    EXPECT_EQ(sl.path(), other_path);
+    EXPECT_EQ(std::vector<int>(sl.begin(), sl.end()), std::vector<int>{2});
+
+    // Замененный файл закрыт контрольной точкой и не требует восстановления
+    persistent_skip_list<int> replaced(path_);
+    EXPECT_FALSE(replaced.recovered());
+    EXPECT_EQ(std::vector<int>(replaced.begin(), replaced.end()), std::vector<int>{1});
+}
+
+TEST_F(PersistentSkipListTest, RejectsCorruptedLinks) {
+    {
+        persistent_skip_list<int> sl(path_);
+        for (int i = 0; i < 100; ++i) {
+            sl.insert(i);
+        }
+    }
+    // Связь уровня 0 головы: заголовок, затем высота и значение головы
+    const std::streamoff head_link = sizeof(detail::offset_heap_header) + 16;
+    uint64_t original = 0;
+    {
+        std::ifstream in(path_, std::ios::binary);
+        in.seekg(head_link);
+        in.read(reinterpret_cast<char*>(&original), sizeof(original));
+    }
+    ASSERT_NE(original, 0u);
+    auto patch = [&](uint64_t link) {
+        std::fstream file(path_, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(head_link);
+        file.write(reinterpret_cast<const char*>(&link), sizeof(link));
+    };
+
+    for (uint64_t link : {original + 1, uint64_t{1} << 40,
+                          static_cast<uint64_t>(head_link - 16)}) {
+        patch(link);
+        EXPECT_THROW(persistent_skip_list<int>{path_}, std::runtime_error) << link;
+    }
+    patch(original);
+    persistent_skip_list<int> sl(path_);
+    EXPECT_EQ(sl.size(), 100);
+}
+
+TEST_F(PersistentSkipListTest, RejectsForeignFiles) {
+    {
+        persistent_skip_list<int64_t> sl(path_);
+        sl.insert(1);
+    }
+    EXPECT_THROW(persistent_skip_list<int32_t>{path_}, std::runtime_error);
+
+    {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out << std::string(4096, 'x');
+    }
+    EXPECT_THROW(persistent_skip_list<int64_t>{path_}, std::runtime_error);
+}
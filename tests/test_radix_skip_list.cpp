@@ -0,0 +1,84 @@
+/**
+ * @file test_radix_skip_list.cpp
+ * @brief Тесты для списка с пропусками с каталогом по старшим битам ключа
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/radix_skip_list.hpp"
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace stl;
+
+class RadixSkipListTest : public ::testing::Test {
+protected:
+    // Сравнивает список с std::set после случайной серии операций
+    template<typename Key, typename Dist>
+    static void check_against_set(radix_skip_list<Key>& sl, Dist dist, int ops) {
+        std::mt19937_64 gen(42);
+        std::set<Key> reference;
+        for (int i = 0; i < ops; ++i) {
+            Key key = dist(gen);
+            if (gen() % 3 == 0) {
+                ASSERT_EQ(sl.erase(key), reference.erase(key));
+            } else {
+                ASSERT_EQ(sl.insert(key).second, reference.insert(key).second);
+            }
+        }
+
+        ASSERT_EQ(sl.size(), reference.size());
+        EXPECT_TRUE(std::equal(sl.begin(), sl.end(), reference.begin(), reference.end()));
+        for (int i = 0; i < 1000; ++i) {
+            Key key = dist(gen);
+            auto it = reference.lower_bound(key);
+            auto found = sl.lower_bound(key);
+            if (it == reference.end()) {
+                EXPECT_EQ(found, sl.end());
+            } else {
+                ASSERT_NE(found, sl.end());
+                EXPECT_EQ(*found, *it);
+            }
+            EXPECT_EQ(sl.contains(key), reference.count(key) != 0);
+        }
+    }
+};
+
+TEST_F(RadixSkipListTest, BasicOperations) {
+    radix_skip_list<uint64_t> sl = {5, 1, 9, 3};
+    EXPECT_EQ(sl.size(), 4);
+    EXPECT_FALSE(sl.insert(5).second);
+    EXPECT_EQ(*sl.lower_bound(4), 5);
+    EXPECT_EQ(*sl.upper_bound(5), 9);
+    EXPECT_EQ(sl.erase(5), 1);
+    EXPECT_EQ(sl.erase(5), 0);
+    EXPECT_EQ(std::vector<uint64_t>(sl.begin(), sl.end()), (std::vector<uint64_t>{1, 3, 9}));
+
+    sl.clear();
+    EXPECT_TRUE(sl.empty());
+    sl.insert(7);
+    EXPECT_TRUE(sl.contains(7));
+}
+
+TEST_F(RadixSkipListTest, DenseIdSpaceMatchesSet) {
+    radix_skip_list<uint64_t> sl(8, 20, 1);
+    check_against_set(sl, std::uniform_int_distribution<uint64_t>(0, (1 << 20) - 1), 20000);
+}
+
+TEST_F(RadixSkipListTest, KeysOutsideKeyBitsAndNegativeKeys) {
+    radix_skip_list<int64_t> narrow(6, 16, 0);
+    check_against_set(narrow, std::uniform_int_distribution<int64_t>(-5000, 200000), 20000);
+
+    radix_skip_list<int32_t> full(10, 32, 2);
+    check_against_set(full, std::uniform_int_distribution<int32_t>(INT32_MIN, INT32_MAX), 20000);
+}
+
+TEST_F(RadixSkipListTest, InvalidGeometryThrows) {
+    EXPECT_THROW(radix_skip_list<uint32_t>(8, 40), std::out_of_range);
+    EXPECT_THROW(radix_skip_list<uint32_t>(20, 16), std::out_of_range);
+    EXPECT_THROW(radix_skip_list<uint32_t>(8, 32, MAX_LEVEL), std::out_of_range);
+}
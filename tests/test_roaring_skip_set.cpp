@@ -0,0 +1,159 @@
+/**
+ * @file test_roaring_skip_set.cpp
+ * @brief Тесты для множества целых с гибридными контейнерами блоков
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/roaring_skip_set.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace stl;
+
+class RoaringSkipSetTest : public ::testing::Test {
+protected:
+    // Заполняет множество и эталон смесью плотных и разреженных ключей
+    static void fill(roaring_skip_set& rs, std::set<uint32_t>& reference, uint64_t seed) {
+        std::mt19937 gen(static_cast<unsigned>(seed));
+        std::uniform_int_distribution<uint32_t> sparse(0, 1u << 22);
+        std::uniform_int_distribution<uint32_t> dense(3u << 16, (3u << 16) + 20000);
+        for (int i = 0; i < 30000; ++i) {
+            uint32_t value = i % 2 == 0 ? sparse(gen) : dense(gen);
+            EXPECT_EQ(rs.insert(value), reference.insert(value).second);
+        }
+    }
+
+    static void expect_equal(const roaring_skip_set& rs, const std::set<uint32_t>& reference) {
+        ASSERT_EQ(rs.size(), reference.size());
+        EXPECT_TRUE(std::equal(rs.begin(), rs.end(), reference.begin(), reference.end()));
+    }
+};
+
+TEST_F(RoaringSkipSetTest, BasicOperations) {
+    roaring_skip_set rs = {70000, 5, 65536, 3};
+    EXPECT_EQ(rs.size(), 4);
+    EXPECT_EQ(rs.chunk_count(), 2);
+    EXPECT_FALSE(rs.insert(5));
+    EXPECT_TRUE(rs.contains(65536));
+    EXPECT_FALSE(rs.contains(65537));
+    EXPECT_EQ(*rs.lower_bound(6), 65536);
+    EXPECT_EQ(rs.lower_bound(70001), rs.end());
+    EXPECT_EQ(rs.rank(4), 1);
+    EXPECT_EQ(rs.rank(70000), 4);
+    EXPECT_EQ(rs.erase(70000), 1);
+    EXPECT_EQ(rs.erase(65536), 1);
+    EXPECT_EQ(rs.chunk_count(), 1);
+    EXPECT_EQ(std::vector<uint32_t>(rs.begin(), rs.end()), (std::vector<uint32_t>{3, 5}));
+}
+
+TEST_F(RoaringSkipSetTest, MatchesReferenceAcrossContainerKinds) {
+    roaring_skip_set rs;
+    std::set<uint32_t> reference;
+    fill(rs, reference, 1);
+    expect_equal(rs, reference);
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<uint32_t> dist(0, 1u << 22);
+    for (int i = 0; i < 2000; ++i) {
+        uint32_t value = i % 2 == 0 ? dist(gen) : (3u << 16) + dist(gen) % 20000;
+        EXPECT_EQ(rs.contains(value), reference.count(value) != 0);
+        auto expected_rank = static_cast<size_t>(
+            std::distance(reference.begin(), reference.upper_bound(value)));
+        EXPECT_EQ(rs.rank(value), expected_rank);
+    }
+
+    // Плотный блок перешел в битовую карту; удаления возвращают его в массив
+    for (uint32_t value = 3u << 16; value < (3u << 16) + 20000; ++value) {
+        EXPECT_EQ(rs.erase(value), reference.erase(value));
+    }
+    expect_equal(rs, reference);
+}
+
+TEST_F(RoaringSkipSetTest, OptimizeCompressesRuns) {
+    roaring_skip_set rs;
+    for (uint32_t value = 0; value < 200000; ++value) {
+        rs.insert(value);
+    }
+    size_t before = rs.memory_usage();
+    rs.optimize();
+    EXPECT_LT(rs.memory_usage(), before / 4);
+    EXPECT_LT(rs.memory_usage(), rs.size() / 10);
+    EXPECT_EQ(rs.size(), 200000);
+    EXPECT_EQ(rs.rank(131071), 131072);
+    EXPECT_TRUE(rs.contains(199999));
+    EXPECT_FALSE(rs.contains(200000));
+
+    // Вставка в список отрезков разворачивает его обратно
+    EXPECT_TRUE(rs.insert(250000));
+    EXPECT_TRUE(rs.erase(100));
+    EXPECT_FALSE(rs.contains(100));
+    EXPECT_EQ(rs.size(), 200000);
+    EXPECT_EQ(*rs.lower_bound(200000), 250000);
+}
+
+TEST_F(RoaringSkipSetTest, RunContainersIterateInOrder) {
+    roaring_skip_set rs;
+    std::set<uint32_t> reference;
+    // Тысяча отрезков с пропусками в одном блоке
+    for (uint32_t value = 0; value < 60000; value += 60) {
+        for (uint32_t i = 0; i < 50; ++i) {
+            rs.insert(value + i);
+            reference.insert(value + i);
+        }
+    }
+    size_t before = rs.memory_usage();
+    rs.optimize();
+    EXPECT_LT(rs.memory_usage(), before);
+    expect_equal(rs, reference);
+    EXPECT_EQ(*rs.lower_bound(55), 60);
+    EXPECT_EQ(*rs.lower_bound(61), 61);
+    EXPECT_EQ(rs.rank(61), 52);
+}
+
+TEST_F(RoaringSkipSetTest, RankTracksInterleavedWrites) {
+    roaring_skip_set rs;
+    std::set<uint32_t> reference;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<uint32_t> dist(0, 1u << 22);
+    for (int i = 0; i < 5000; ++i) {
+        uint32_t value = dist(gen);
+        if (i % 3 == 2) {
+            EXPECT_EQ(rs.erase(value), reference.erase(value));
+        } else {
+            EXPECT_EQ(rs.insert(value), reference.insert(value).second);
+        }
+        uint32_t probe = dist(gen);
+        auto expected_rank = static_cast<size_t>(
+            std::distance(reference.begin(), reference.upper_bound(probe)));
+        ASSERT_EQ(rs.rank(probe), expected_rank);
+    }
+}
+
+TEST_F(RoaringSkipSetTest, SetOperationsMatchReference) {
+    roaring_skip_set a;
+    roaring_skip_set b;
+    std::set<uint32_t> ra;
+    std::set<uint32_t> rb;
+    fill(a, ra, 1);
+    fill(b, rb, 2);
+    b.optimize();
+
+    std::set<uint32_t> expected_and;
+    std::set<uint32_t> expected_or;
+    std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(),
+                          std::inserter(expected_and, expected_and.end()));
+    std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(),
+                   std::inserter(expected_or, expected_or.end()));
+
+    expect_equal(a & b, expected_and);
+    expect_equal(a | b, expected_or);
+    EXPECT_TRUE((a | b) == (b | a));
+    EXPECT_TRUE((a & a) == a);
+}
@@ -8,10 +8,19 @@
 
 #include <gtest/gtest.h>
 #include "../include/skip_list.hpp"
+#include "../include/skip_list_dump.hpp"
+#include "temp_dir.hpp"
 #include <vector>
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <set>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <filesystem>
+#include <memory>
+#include <string>
 
 using namespace stl;
 
@@ -287,6 +296,235 @@ TEST_F(SkipListTest, Clear) {
     EXPECT_EQ(sl.size(), 0);
 }
 
+TEST_F(SkipListTest, EraseByKey) {
+    skip_list<int> sl = {1, 2, 3, 4, 5};
+
+    EXPECT_EQ(sl.erase(3), 1);
+    EXPECT_EQ(sl.erase(42), 0);
+    EXPECT_EQ(sl.size(), 4);
+    EXPECT_EQ(sl.find(3), sl.end());
+
+    std::vector<int> actual(sl.begin(), sl.end());
+    EXPECT_EQ(actual, (std::vector<int>{1, 2, 4, 5}));
+}
+
+TEST_F(SkipListTest, EraseByIterator) {
+    skip_list<int> sl = {1, 2, 3};
+
+    auto next = sl.erase(sl.find(2));
+    EXPECT_EQ(*next, 3);
+    EXPECT_EQ(sl.erase(sl.find(3)), sl.end());
+    EXPECT_EQ(sl.size(), 1);
+    EXPECT_THROW(sl.erase(sl.end()), std::out_of_range);
+}
+
+TEST_F(SkipListTest, EraseAllThenInsert) {
+    skip_list<int> sl;
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(sl.erase(i), 1);
+    }
+    EXPECT_TRUE(sl.empty());
+    EXPECT_EQ(sl.begin(), sl.end());
+
+    sl.insert(7);
+    EXPECT_EQ(*sl.begin(), 7);
+}
+
+TEST_F(SkipListTest, DestroyLongListWithoutRecursion) {
+    // Рекурсивное разрушение цепочки shared_ptr такой длины переполняло стек
+    auto sl = std::make_unique<skip_list<int>>();
+    for (int i = 0; i < 300000; ++i) {
+        sl->insert(i);
+    }
+    sl->clear();
+    EXPECT_TRUE(sl->empty());
+
+    for (int i = 0; i < 300000; ++i) {
+        sl->insert(i);
+    }
+    sl.reset();
+    SUCCEED();
+}
+
+TEST_F(SkipListTest, IndexCacheMatchesPlainSearch) {
+    skip_list<int> sl;
+    std::set<int> reference;
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    for (int i = 0; i < 5000; ++i) {
+        int key = dist(gen);
+        sl.insert(key);
+        reference.insert(key);
+    }
+
+    // Кэш строится по готовому списку и дальше поддерживается изменениями
+    sl.set_index_cache(2);
+    EXPECT_EQ(sl.index_cache_level(), 2);
+    EXPECT_GT(sl.index_cache_size(), 0);
+    for (int i = 0; i < 20000; ++i) {
+        int key = dist(gen);
+        if (i % 3 == 0) {
+            ASSERT_EQ(sl.erase(key), reference.erase(key));
+        } else {
+            ASSERT_EQ(sl.insert(key).second, reference.insert(key).second);
+        }
+        if (i == 10000) {
+            skip_list<int>::maintenance_cursor towers;
+            while (!towers.done) {
+                sl.rebuild_towers(towers, 100);
+            }
+            skip_list<int>::maintenance_cursor moves;
+            while (!moves.done) {
+                sl.compact(moves, 100);
+            }
+        }
+    }
+
+    ASSERT_EQ(sl.size(), reference.size());
+    EXPECT_TRUE(std::equal(sl.begin(), sl.end(), reference.begin(), reference.end()));
+    for (int key = -1; key <= 20001; ++key) {
+        auto lower = reference.lower_bound(key);
+        auto upper = reference.upper_bound(key);
+        ASSERT_EQ(sl.count(key), reference.count(key));
+        ASSERT_EQ(sl.lower_bound(key) == sl.end(), lower == reference.end());
+        ASSERT_EQ(sl.upper_bound(key) == sl.end(), upper == reference.end());
+        if (lower != reference.end()) {
+            ASSERT_EQ(*sl.lower_bound(key), *lower);
+        }
+        if (upper != reference.end()) {
+            ASSERT_EQ(*sl.upper_bound(key), *upper);
+        }
+        ASSERT_EQ(std::as_const(sl).lower_bound(key).get_node(), sl.lower_bound(key).get_node());
+        ASSERT_EQ(std::as_const(sl).upper_bound(key).get_node(), sl.upper_bound(key).get_node());
+    }
+
+    skip_list<int> copy(sl);
+    EXPECT_EQ(copy.index_cache_level(), 2);
+    EXPECT_TRUE(copy == sl);
+    sl.clear();
+    EXPECT_EQ(sl.index_cache_size(), 0);
+    EXPECT_EQ(sl.find(100), sl.end());
+}
+
+TEST_F(SkipListTest, FindBatchMatchesFind) {
+    skip_list<int64_t> sl;
+    std::mt19937_64 gen(9);
+    std::uniform_int_distribution<int64_t> dist(-50000, 50000);
+    for (int i = 0; i < 20000; ++i) {
+        sl.insert(dist(gen));
+    }
+
+    // Размер пакета не кратен числу полос
+    std::vector<int64_t> keys(1003);
+    for (auto& key : keys) {
+        key = dist(gen);
+    }
+    keys.push_back(std::numeric_limits<int64_t>::min());
+    keys.push_back(std::numeric_limits<int64_t>::max());
+
+    auto found = sl.find_batch(keys);
+    ASSERT_EQ(found.size(), keys.size());
+    const auto& view = sl;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(found[i], view.find(keys[i]));
+    }
+
+    skip_list<unsigned, std::greater<unsigned>> reversed = {1, 5, 9};
+    auto reversed_found = reversed.find_batch({9, 2});
+    EXPECT_EQ(*reversed_found[0], 9u);
+    EXPECT_EQ(reversed_found[1], std::as_const(reversed).end());
+    EXPECT_TRUE(skip_list<int>().find_batch({}).empty());
+}
+
+TEST_F(SkipListTest, DumpIsPointInTime) {
+    test::temp_dir dir("skip_list_dump");
+    std::string path = dir.file("list.dump");
+    auto read_back = [&path] {
+        std::vector<int> values;
+        read_dump<raw_codec<int>>(path, [&values](int value) { values.push_back(value); });
+        return values;
+    };
+
+    skip_list<int> sl;
+    for (int i = 0; i < 20000; i += 2) {
+        sl.insert(i);
+    }
+    std::vector<int> snapshot(sl.begin(), sl.end());
+
+    {
+        skip_list_dump<skip_list<int>> dump(sl, path);
+        std::mt19937 gen(123);
+        std::uniform_int_distribution<int> dist(0, 20000);
+        for (int i = 0; i < 20000; ++i) {
+            int key = dist(gen);
+            if (i % 2 == 0) {
+                sl.erase(key);
+            } else {
+                sl.insert(key);
+            }
+            if (i % 1000 == 0) {
+                dump.step(100);
+            }
+        }
+        EXPECT_FALSE(std::filesystem::exists(path));
+        dump.finish();
+        EXPECT_FALSE(dump.active());
+    }
+    EXPECT_EQ(read_back(), snapshot);
+
+    // clear() посреди дампа не теряет недописанный остаток снимка
+    snapshot = std::vector<int>(sl.begin(), sl.end());
+    {
+        skip_list_dump<skip_list<int>> dump(sl, path);
+        dump.step(snapshot.size() / 3);
+        sl.clear();
+        for (int i = 0; i < 100; ++i) {
+            sl.insert(i * 7);
+        }
+        dump.finish();
+    }
+    EXPECT_EQ(read_back(), snapshot);
+
+    // Как и перемещение списка, разрушение не обрывает начатый дамп
+    snapshot = std::vector<int>(sl.begin(), sl.end());
+    auto owner = std::make_unique<skip_list<int>>(std::move(sl));
+    skip_list_dump<skip_list<int>> dump(*owner, path);
+    dump.step(10);
+    skip_list<int> moved(std::move(*owner));
+    moved.erase(snapshot.back());
+    owner.reset();
+    moved = skip_list<int>();
+    dump.finish();
+    EXPECT_EQ(read_back(), snapshot);
+}
+
+TEST_F(SkipListTest, FrontAndPopFront) {
+    skip_list<int> sl = {5, 1, 3};
+    EXPECT_EQ(sl.front(), 1);
+    sl.pop_front();
+    EXPECT_EQ(sl.front(), 3);
+    sl.pop_front();
+    sl.pop_front();
+    EXPECT_TRUE(sl.empty());
+    EXPECT_THROW(sl.front(), std::out_of_range);
+    EXPECT_THROW(sl.pop_front(), std::out_of_range);
+
+    sl.set_index_cache(1);
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert(i);
+    }
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(sl.front(), i);
+        sl.pop_front();
+    }
+    EXPECT_EQ(sl.size(), 500);
+    EXPECT_EQ(sl.count(700), 1);
+    EXPECT_EQ(sl.count(300), 0);
+}
+
 TEST_F(SkipListTest, Swap) {
     skip_list<int> sl1 = {1, 2, 3};
     skip_list<int> sl2 = {4, 5, 6};
@@ -0,0 +1,78 @@
+/**
+ * @file test_sort_key_skip_list.cpp
+ * @brief Тесты для списка с пропусками с ключами сортировки
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/sort_key_skip_list.hpp"
+#include <cctype>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+class SortKeySkipListTest : public ::testing::Test {
+protected:
+    // Регистронезависимый ключ; считает вызовы, чтобы проверить, что
+    // ключ строится один раз на элемент
+    struct case_insensitive_key {
+        int* calls;
+
+        std::string operator()(const std::string& value) const {
+            ++*calls;
+            std::string key = value;
+            for (char& c : key) {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            return key;
+        }
+    };
+};
+
+TEST_F(SortKeySkipListTest, OrdersByCollationKey) {
+    sort_key_skip_list<std::string> names(collate_sort_key(std::locale::classic()));
+    names.insert("delta");
+    names.insert("alpha");
+    names.insert("charlie");
+    EXPECT_FALSE(names.insert("alpha").second);
+
+    EXPECT_EQ(std::vector<std::string>(names.begin(), names.end()),
+              (std::vector<std::string>{"alpha", "charlie", "delta"}));
+    EXPECT_TRUE(names.contains("charlie"));
+    EXPECT_EQ(*names.lower_bound("b"), "charlie");
+    EXPECT_EQ(names.upper_bound("delta"), names.end());
+}
+
+TEST_F(SortKeySkipListTest, KeyComputedOncePerElementAndLookup) {
+    int calls = 0;
+    sort_key_skip_list<std::string, case_insensitive_key> names(case_insensitive_key{&calls});
+    for (const char* name : {"Bob", "alice", "Carol", "dave", "Eve"}) {
+        names.insert(name);
+    }
+    EXPECT_EQ(calls, 5);
+
+    calls = 0;
+    EXPECT_TRUE(names.contains("ALICE"));
+    EXPECT_EQ(*names.find("CAROL"), "Carol");
+    EXPECT_EQ(calls, 2);
+
+    EXPECT_FALSE(names.insert("BOB").second);
+    EXPECT_EQ(names.erase("EVE"), 1);
+    EXPECT_EQ(std::vector<std::string>(names.begin(), names.end()),
+              (std::vector<std::string>{"alice", "Bob", "Carol", "dave"}));
+}
+
+TEST_F(SortKeySkipListTest, BytesCompareUnsigned) {
+    int calls = 0;
+    sort_key_skip_list<std::string, case_insensitive_key> values(case_insensitive_key{&calls});
+    values.insert(std::string("\xff"));
+    values.insert(std::string("a"));
+    values.insert(std::string("ab"));
+
+    EXPECT_EQ(std::vector<std::string>(values.begin(), values.end()),
+              (std::vector<std::string>{"a", "ab", "\xff"}));
+    EXPECT_EQ(values.begin().sort_key(), "a");
+}
@@ -0,0 +1,110 @@
+/**
+ * @file test_string_skip_list.cpp
+ * @brief Тесты для списка строк с ключами в арене
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/string_skip_list.hpp"
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace stl;
+
+class StringSkipListTest : public ::testing::Test {
+protected:
+    static std::string random_key(std::mt19937& gen) {
+        // Короткий алфавит и общие префиксы проверяют сравнение за пределами
+        // первых восьми байт
+        static const std::string prefixes[] = {"", "user:", "user:000", std::string("\0x", 2)};
+        std::string key = prefixes[gen() % 4];
+        size_t length = gen() % 12;
+        for (size_t i = 0; i < length; ++i) {
+            key.push_back(static_cast<char>("ab\0\xff"[gen() % 4]));
+        }
+        return key;
+    }
+
+    static void expect_matches(const string_skip_list& sl, const std::set<std::string>& ref) {
+        ASSERT_EQ(sl.size(), ref.size());
+        EXPECT_TRUE(std::equal(sl.begin(), sl.end(), ref.begin(), ref.end()));
+    }
+};
+
+TEST_F(StringSkipListTest, BasicOperations) {
+    string_skip_list sl = {"pear", "apple", "applesauce", "fig"};
+    EXPECT_EQ(sl.size(), 4);
+    EXPECT_FALSE(sl.insert("fig").second);
+    EXPECT_TRUE(sl.insert("").second);
+    EXPECT_EQ(*sl.begin(), "");
+    EXPECT_EQ(*sl.lower_bound("applet"), "fig");
+    EXPECT_EQ(*sl.upper_bound("apple"), "applesauce");
+    EXPECT_TRUE(sl.contains("applesauce"));
+    EXPECT_EQ(sl.erase("apple"), 1);
+    EXPECT_EQ(sl.erase("apple"), 0);
+    EXPECT_EQ(std::vector<std::string_view>(sl.begin(), sl.end()),
+              (std::vector<std::string_view>{"", "applesauce", "fig", "pear"}));
+}
+
+TEST_F(StringSkipListTest, MatchesReferenceOrdering) {
+    string_skip_list sl;
+    std::set<std::string> reference;
+    std::mt19937 gen(13);
+    for (int i = 0; i < 20000; ++i) {
+        std::string key = random_key(gen);
+        if (gen() % 3 == 0) {
+            ASSERT_EQ(sl.erase(key), reference.erase(key));
+        } else {
+            ASSERT_EQ(sl.insert(key).second, reference.insert(key).second);
+        }
+    }
+    expect_matches(sl, reference);
+
+    for (int i = 0; i < 2000; ++i) {
+        std::string key = random_key(gen);
+        auto expected = reference.lower_bound(key);
+        auto found = sl.lower_bound(key);
+        if (expected == reference.end()) {
+            ASSERT_EQ(found, sl.end());
+        } else {
+            ASSERT_EQ(*found, *expected);
+        }
+    }
+}
+
+TEST_F(StringSkipListTest, CompactReclaimsErasedKeyBytes) {
+    string_skip_list sl;
+    std::set<std::string> reference;
+    for (int i = 0; i < 10000; ++i) {
+        std::string key = "key-" + std::to_string(i) + std::string(40, 'x');
+        sl.insert(key);
+        reference.insert(key);
+    }
+    size_t live = sl.live_key_bytes();
+    for (int i = 0; i < 10000; i += 2) {
+        std::string key = "key-" + std::to_string(i) + std::string(40, 'x');
+        sl.erase(key);
+        reference.erase(key);
+    }
+    EXPECT_GT(sl.dead_key_bytes(), 0);
+    EXPECT_EQ(sl.live_key_bytes() + sl.dead_key_bytes(), live);
+
+    size_t before = sl.arena_bytes();
+    auto it = sl.find(*reference.begin());
+    sl.compact();
+    EXPECT_EQ(sl.dead_key_bytes(), 0);
+    EXPECT_LT(sl.arena_bytes(), before);
+    EXPECT_EQ(*it, *reference.begin());
+    expect_matches(sl, reference);
+
+    sl.clear();
+    EXPECT_TRUE(sl.empty());
+    EXPECT_EQ(sl.arena_bytes(), 0);
+    EXPECT_TRUE(sl.insert("again").second);
+    EXPECT_EQ(*sl.begin(), "again");
+}
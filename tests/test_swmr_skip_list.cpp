@@ -0,0 +1,247 @@
+/**
+ * @file test_swmr_skip_list.cpp
+ * @brief Тесты для списка с пропусками "один писатель, много читателей"
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/swmr_skip_list.hpp"
+#include <atomic>
+#include <latch>
+#include <thread>
+#include <vector>
+
+using namespace stl;
+
+class SwmrSkipListTest : public ::testing::Test {
+};
+
+TEST_F(SwmrSkipListTest, InsertAndFind) {
+    swmr_skip_list<int> sl;
+    EXPECT_TRUE(sl.insert(5).second);
+    EXPECT_TRUE(sl.insert(1).second);
+    EXPECT_TRUE(sl.insert(3).second);
+    EXPECT_FALSE(sl.insert(3).second);
+
+    EXPECT_EQ(sl.size(), 3);
+    EXPECT_TRUE(sl.contains(3));
+    EXPECT_FALSE(sl.contains(4));
+    EXPECT_EQ(*sl.find(5), 5);
+    EXPECT_EQ(sl.find(4), sl.end());
+}
+
+TEST_F(SwmrSkipListTest, Bounds) {
+    swmr_skip_list<int> sl = {1, 3, 5, 7, 9};
+
+    EXPECT_EQ(*sl.lower_bound(4), 5);
+    EXPECT_EQ(*sl.lower_bound(5), 5);
+    EXPECT_EQ(*sl.upper_bound(5), 7);
+    EXPECT_EQ(sl.upper_bound(9), sl.end());
+}
+
+TEST_F(SwmrSkipListTest, EraseAndIterate) {
+    swmr_skip_list<int> sl = {1, 2, 3, 4, 5};
+    EXPECT_EQ(sl.erase(3), 1);
+    EXPECT_EQ(sl.erase(42), 0);
+
+    std::vector<int> actual(sl.begin(), sl.end());
+    EXPECT_EQ(actual, (std::vector<int>{1, 2, 4, 5}));
+    EXPECT_EQ(sl.size(), 4);
+}
+
+TEST_F(SwmrSkipListTest, IteratorSurvivesErase) {
+    swmr_skip_list<int> sl = {1, 2, 3};
+    auto it = sl.find(2);
+
+    sl.erase(2);
+    sl.reclaim();
+
+    EXPECT_EQ(*it, 2);
+    ++it;
+    EXPECT_EQ(*it, 3);
+}
+
+TEST_F(SwmrSkipListTest, ClearRetiresNodes) {
+    swmr_skip_list<int> sl;
+    for (int i = 0; i < 100; ++i) {
+        sl.insert(i);
+    }
+    sl.clear();
+
+    EXPECT_TRUE(sl.empty());
+    EXPECT_EQ(sl.begin(), sl.end());
+    sl.reclaim();
+    sl.insert(7);
+    EXPECT_EQ(*sl.begin(), 7);
+}
+
+TEST_F(SwmrSkipListTest, ConcurrentReadersSeeSortedList) {
+    swmr_skip_list<int> sl;
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            bool seen_zero = false;
+            while (!done.load()) {
+                int previous = -1;
+                for (int value : sl) {
+                    if (value <= previous) {
+                        ++errors;
+                    }
+                    previous = value;
+                }
+                // Четные ключи писатель никогда не удаляет
+                bool has_zero = sl.contains(0);
+                if (seen_zero && !has_zero) {
+                    ++errors;
+                }
+                seen_zero = seen_zero || has_zero;
+            }
+        });
+    }
+
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 500; ++i) {
+            sl.insert(i);
+        }
+        for (int i = 1; i < 500; i += 2) {
+            sl.erase(i);
+        }
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(sl.size(), 250);
+}
+
+TEST_F(SwmrSkipListTest, ManyLiveReaderThreads) {
+    swmr_skip_list<int> sl = {1, 2, 3};
+    // Больше потоков, чем слотов в первом блоке реклеймера; все живы
+    // одновременно и держат закрепление, пока писатель удаляет узлы
+    constexpr int READERS = 200;
+    std::latch pinned(READERS);
+    std::atomic<bool> release{false};
+    std::atomic<int> found{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&] {
+            auto it = sl.find(2);
+            found += it != sl.end() ? 1 : 0;
+            pinned.count_down();
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+            EXPECT_EQ(*it, 2);
+        });
+    }
+    pinned.wait();
+    sl.erase(2);
+    release = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(found.load(), READERS);
+    EXPECT_FALSE(sl.contains(2));
+}
+
+TEST_F(SwmrSkipListTest, ForwardIteratorConcept) {
+    static_assert(std::forward_iterator<swmr_skip_list<int>::const_iterator>,
+                  "Итератор должен быть forward_iterator");
+    EXPECT_TRUE(true);
+}
+
+TEST_F(SwmrSkipListTest, ScanReturnsClosedRange) {
+    swmr_skip_list<int> sl = {1, 3, 5, 7, 9};
+
+    EXPECT_EQ(sl.scan(3, 7), (std::vector<int>{3, 5, 7}));
+    EXPECT_EQ(sl.scan(2, 8), (std::vector<int>{3, 5, 7}));
+    EXPECT_EQ(sl.scan(10, 20), std::vector<int>{});
+    EXPECT_EQ(sl.scan(0, 100).size(), 5);
+}
+
+TEST_F(SwmrSkipListTest, ScanIsConsistentUnderWrites) {
+    swmr_skip_list<int> sl;
+    for (int i = 0; i < 200; i += 2) {
+        sl.insert(i);
+    }
+    sl.insert(1001);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            // Писатель сначала вставляет следующий маркер, затем удаляет
+            // предыдущий, поэтому согласованный срез всегда содержит маркер
+            auto values = sl.scan(1000, 2000);
+            if (values.empty()) {
+                ++errors;
+            }
+        }
+    });
+
+    for (int marker = 1001; marker < 1999; ++marker) {
+        sl.insert(marker + 1);
+        sl.erase(marker);
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(sl.scan(1000, 2000), std::vector<int>{1999});
+}
+
+TEST_F(SwmrSkipListTest, ApplyBatchKeepsLastOperationPerKey) {
+    swmr_skip_list<int> sl = {1, 2, 3};
+
+    write_batch<int> batch;
+    batch.insert(5).erase(2).insert(2).erase(3).insert(4).erase(4).erase(7);
+    EXPECT_EQ(sl.apply_batch(std::move(batch)), 2);
+
+    EXPECT_EQ(std::vector<int>(sl.begin(), sl.end()), (std::vector<int>{1, 2, 5}));
+    EXPECT_EQ(sl.size(), 3);
+    EXPECT_EQ(sl.apply_batch(write_batch<int>()), 0);
+}
+
+TEST_F(SwmrSkipListTest, ApplyBatchIsAtomicForReaders) {
+    swmr_skip_list<int> sl;
+    const int count = 64;
+    for (int i = 0; i < count; ++i) {
+        sl.insert(i);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            // Каждый пакет переносит половину ключей, сохраняя их число
+            if (sl.scan(0, 1 << 20).size() != static_cast<size_t>(count)) {
+                ++errors;
+            }
+        }
+    });
+
+    for (int round = 0; round < 200; ++round) {
+        write_batch<int> batch;
+        int base = round * count;
+        for (int i = 0; i < count; ++i) {
+            batch.erase(base + i);
+            batch.insert(base + count + i);
+        }
+        sl.apply_batch(std::move(batch));
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(sl.size(), static_cast<size_t>(count));
+    EXPECT_EQ(*sl.begin(), 200 * count);
+}
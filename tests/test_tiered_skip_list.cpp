@@ -0,0 +1,175 @@
+/**
+ * @file test_tiered_skip_list.cpp
+ * @brief Тесты для списка с пропусками с выгрузкой холодных диапазонов
+ * @author Pan Vladimir
+ * @version 1.0
+ * @date 2025
+ */
+
+#include <gtest/gtest.h>
+#include "../include/tiered_skip_list.hpp"
+#include "temp_dir.hpp"
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace stl;
+
+class TieredSkipListTest : public ::testing::Test {
+protected:
+    tiered_options options(size_t max_resident, size_t segment_size) const {
+        return tiered_options{dir_.path().string(), max_resident, segment_size};
+    }
+
+    test::temp_dir dir_{"tiered_skip_list"};
+};
+
+TEST_F(TieredSkipListTest, StaysWithinBudgetAndMatchesReference) {
+    tiered_skip_list<int> sl(options(200, 32));
+    std::set<int> reference;
+    std::mt19937 gen(19);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    for (int i = 0; i < 3000; ++i) {
+        int key = dist(gen);
+        if (i % 4 == 0) {
+            ASSERT_EQ(sl.erase(key), reference.erase(key));
+        } else {
+            ASSERT_EQ(sl.insert(key), reference.insert(key).second);
+        }
+        // Бюджет может превышать только текущий диапазон
+        ASSERT_LE(sl.resident_elements(), 200 + 2 * 32 + 1);
+    }
+
+    EXPECT_EQ(sl.size(), reference.size());
+    EXPECT_GT(sl.spilled_segments(), 0);
+    EXPECT_FALSE(dir_.empty());
+
+    for (int i = 0; i < 500; ++i) {
+        int key = dist(gen);
+        ASSERT_EQ(sl.contains(key), reference.count(key) != 0);
+        auto expected = reference.lower_bound(key);
+        auto found = sl.lower_bound(key);
+        ASSERT_EQ(found.has_value(), expected != reference.end());
+        if (found) {
+            ASSERT_EQ(*found, *expected);
+        }
+    }
+
+    std::vector<int> all;
+    sl.for_each([&all](int value) { all.push_back(value); });
+    EXPECT_EQ(all, std::vector<int>(reference.begin(), reference.end()));
+    EXPECT_LE(sl.resident_elements(), 200 + 2 * 32 + 1);
+}
+
+TEST_F(TieredSkipListTest, SpilledStringsRoundTrip) {
+    {
+        tiered_skip_list<std::string, std::less<std::string>, string_codec> sl(options(10, 4));
+        for (int i = 0; i < 100; ++i) {
+            sl.insert("key-" + std::to_string(i));
+        }
+        sl.spill_all();
+        EXPECT_EQ(sl.resident_elements(), 0);
+        EXPECT_EQ(sl.spilled_segments(), sl.segment_count());
+        EXPECT_TRUE(sl.contains("key-42"));
+        EXPECT_FALSE(sl.contains("key-420"));
+        EXPECT_EQ(sl.lower_bound("key-99a"), std::nullopt);
+        EXPECT_EQ(sl.erase("key-42"), 1);
+        EXPECT_EQ(sl.size(), 99);
+    }
+    // Деструктор удаляет файлы диапазонов
+    EXPECT_TRUE(dir_.empty());
+}
+
+TEST_F(TieredSkipListTest, CompressesColdRangesInMemory) {
+    tiered_options opts;
+    opts.max_resident = 256;
+    opts.segment_size = 64;
+    opts.compress = true;
+    tiered_skip_list<int64_t, std::less<int64_t>, lz_codec<delta_varint_codec<int64_t>>> sl(opts);
+    std::set<int64_t> reference;
+    for (int64_t i = 0; i < 5000; ++i) {
+        sl.insert(i * 10);
+        reference.insert(i * 10);
+    }
+    EXPECT_GT(sl.compressed_segments(), 0);
+    EXPECT_EQ(sl.spilled_segments(), 0);
+    EXPECT_LT(sl.compressed_bytes(), (5000 - sl.resident_elements()) * sizeof(int64_t) / 2);
+
+    // Горячий диапазон остается в памяти, холодные распаковываются по запросу
+    for (int round = 0; round < 50; ++round) {
+        ASSERT_TRUE(sl.contains(40000));
+    }
+    EXPECT_TRUE(sl.contains(10));
+    EXPECT_TRUE(sl.contains(40000));
+    EXPECT_EQ(sl.erase(10), 1);
+    reference.erase(10);
+    EXPECT_EQ(sl.lower_bound(11), std::optional<int64_t>(20));
+
+    std::vector<int64_t> all;
+    sl.for_each([&all](int64_t value) { all.push_back(value); });
+    EXPECT_EQ(all, std::vector<int64_t>(reference.begin(), reference.end()));
+    EXPECT_LE(sl.resident_elements(), 256 + 2 * 64 + 1);
+}
+
+TEST_F(TieredSkipListTest, SpillsCompressedBlocksOverBudget) {
+    tiered_options opts = options(64, 16);
+    opts.compress = true;
+    opts.max_compressed_bytes = 256;
+    tiered_skip_list<int, std::less<int>, lz_codec<raw_codec<int>>> sl(opts);
+    std::set<int> reference;
+    std::mt19937 gen(120);
+    std::uniform_int_distribution<int> dist(0, 5000);
+    for (int i = 0; i < 5000; ++i) {
+        int key = dist(gen);
+        if (i % 3 == 0) {
+            ASSERT_EQ(sl.erase(key), reference.erase(key));
+        } else {
+            ASSERT_EQ(sl.insert(key), reference.insert(key).second);
+        }
+        ASSERT_LE(sl.compressed_bytes(), 256);
+    }
+    EXPECT_GT(sl.spilled_segments(), 0);
+    EXPECT_FALSE(dir_.empty());
+
+    std::vector<int> all;
+    sl.for_each([&all](int value) { all.push_back(value); });
+    EXPECT_EQ(all, std::vector<int>(reference.begin(), reference.end()));
+}
+
+TEST_F(TieredSkipListTest, IteratorPinsSegmentAndFaultsInNext) {
+    static_assert(std::forward_iterator<tiered_skip_list<int>::const_iterator>,
+                  "Итератор должен быть forward_iterator");
+    tiered_skip_list<int> sl(options(64, 16));
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i) {
+        sl.insert(i * 3);
+        expected.push_back(i * 3);
+    }
+    sl.spill_all();
+    EXPECT_EQ(sl.resident_elements(), 0);
+
+    std::vector<int> all;
+    for (auto it = sl.begin(); it != sl.end(); ++it) {
+        all.push_back(*it);
+        // Обращения к другим диапазонам не вытесняют закрепленный
+        ASSERT_TRUE(sl.contains((*it + 1500) % 3000 / 3 * 3));
+        ASSERT_LE(sl.resident_elements(), 64 + 3 * 32 + 1);
+    }
+    EXPECT_EQ(all, expected);
+
+    auto first = sl.begin();
+    auto copy = first;
+    EXPECT_EQ(*copy, 0);
+    sl.spill_all();
+    EXPECT_EQ(*++copy, 3);
+    EXPECT_EQ(std::vector<int>(sl.begin(), sl.end()), expected);
+}
+
+TEST_F(TieredSkipListTest, RejectsEmptyBudget) {
+    EXPECT_THROW(tiered_skip_list<int>(options(0, 16)), std::out_of_range);
+    EXPECT_THROW(tiered_skip_list<int>(tiered_options{}), std::out_of_range);
+}